@@ -11,6 +11,20 @@
 
 #include "bb_node.h"
 
+#include "../../util/limbo_compat.h"
+#include "../../util/limbo_string_names.h"
+
+Variant BBNode::_resolve_node(Node *p_scene_root, const Variant &p_value, const Variant &p_default) const {
+	if (p_value.get_type() == Variant::NODE_PATH) {
+		return p_scene_root->get_node_or_null(p_value);
+	} else if (p_value.get_type() == Variant::OBJECT || p_value.get_type() == Variant::NIL) {
+		return p_value;
+	} else {
+		WARN_PRINT("BBNode: Unexpected variant type: " + Variant::get_type_name(p_value.get_type()) + ". Returning default value.");
+		return p_default;
+	}
+}
+
 Variant BBNode::get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, const Variant &p_default) {
 	ERR_FAIL_NULL_V_MSG(p_scene_root, Variant(), "BBNode: get_value() failed - scene_root is null.");
 	ERR_FAIL_NULL_V_MSG(p_blackboard, Variant(), "BBNode: get_value() failed - blackboard is null.");
@@ -21,13 +35,60 @@ Variant BBNode::get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboar
 	} else {
 		val = p_blackboard->get_var(get_variable(), p_default);
 	}
+	return _resolve_node(p_scene_root, val, p_default);
+}
+
+Variant BBNode::get_value_by_handle(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, BBHandle &r_handle, const Variant &p_default) {
+	if (get_value_source() == SAVED_VALUE) {
+		return get_value(p_scene_root, p_blackboard, p_default);
+	}
+	ERR_FAIL_NULL_V_MSG(p_scene_root, Variant(), "BBNode: get_value() failed - scene_root is null.");
+	ERR_FAIL_NULL_V_MSG(p_blackboard, Variant(), "BBNode: get_value() failed - blackboard is null.");
 
-	if (val.get_type() == Variant::NODE_PATH) {
-		return p_scene_root->get_node_or_null(val);
-	} else if (val.get_type() == Variant::OBJECT || val.get_type() == Variant::NIL) {
-		return val;
+	if (unlikely(r_handle.name != get_variable())) {
+		r_handle = BBHandle(get_variable());
+	}
+	return _resolve_node(p_scene_root, p_blackboard->get_var_by_handle(r_handle, p_default), p_default);
+}
+
+Variant BBNode::get_value_cached(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, BBHandle &r_handle, BBNodeCache &r_cache, const Variant &p_default) {
+	Variant val;
+	if (get_value_source() == SAVED_VALUE) {
+		val = get_saved_value();
 	} else {
-		WARN_PRINT("BBNode: Unexpected variant type: " + Variant::get_type_name(val.get_type()) + ". Returning default value.");
-		return p_default;
+		ERR_FAIL_NULL_V_MSG(p_blackboard, Variant(), "BBNode: get_value() failed - blackboard is null.");
+		if (unlikely(r_handle.name != get_variable())) {
+			r_handle = BBHandle(get_variable());
+		}
+		val = p_blackboard->get_var_by_handle(r_handle, p_default);
+	}
+	if (val.get_type() != Variant::NODE_PATH) {
+		// Objects don't need resolving.
+		return _resolve_node(p_scene_root, val, p_default);
+	}
+
+	const NodePath path = val;
+	if (likely(r_cache.valid && r_cache.path == path)) {
+		Node *node = Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(r_cache.node_id));
+		if (likely(node)) {
+			return node;
+		}
+	}
+
+	ERR_FAIL_NULL_V_MSG(p_scene_root, Variant(), "BBNode: get_value() failed - scene_root is null.");
+	Node *prev = r_cache.valid ? Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(r_cache.node_id)) : nullptr;
+	if (prev && prev->is_connected(LW_NAME(tree_exiting), r_cache.on_tree_exiting)) {
+		prev->disconnect(LW_NAME(tree_exiting), r_cache.on_tree_exiting);
+	}
+	r_cache.invalidate();
+
+	Node *node = p_scene_root->get_node_or_null(path);
+	if (node && node->is_inside_tree() && r_cache.on_tree_exiting.is_valid()) {
+		// Nodes outside of the tree are not cached, as they won't notify when moved.
+		r_cache.path = path;
+		r_cache.node_id = node->get_instance_id();
+		r_cache.valid = true;
+		node->connect(LW_NAME(tree_exiting), r_cache.on_tree_exiting, CONNECT_ONE_SHOT);
 	}
+	return node;
 }
@@ -14,15 +14,34 @@
 
 #include "bb_param.h"
 
+// Node resolved from a NodePath by BBNode::get_value_cached().
+// Owned by the task, as parameters may be shared between tasks.
+struct BBNodeCache {
+	NodePath path;
+	ObjectID node_id;
+	bool valid = false;
+	Callable on_tree_exiting; // Connected to the cached node; expected to call invalidate().
+
+	_FORCE_INLINE_ void invalidate() { valid = false; }
+};
+
 class BBNode : public BBParam {
 	GDCLASS(BBNode, BBParam);
 
+private:
+	Variant _resolve_node(Node *p_scene_root, const Variant &p_value, const Variant &p_default) const;
+
 protected:
 	static void _bind_methods() {}
 
 public:
 	virtual Variant::Type get_type() const override { return Variant::NODE_PATH; }
 	virtual Variant get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, const Variant &p_default = Variant()) override;
+	virtual Variant get_value_by_handle(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, BBHandle &r_handle, const Variant &p_default = Variant()) override;
+
+	// Same as get_value_by_handle(), but a node resolved from a path is cached until the path changes,
+	// or the node exits the tree.
+	Variant get_value_cached(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, BBHandle &r_handle, BBNodeCache &r_cache, const Variant &p_default = Variant());
 };
 
 #endif // BB_NODE_H
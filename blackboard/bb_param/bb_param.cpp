@@ -79,16 +79,38 @@ Variant BBParam::get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboa
 	ERR_FAIL_COND_V(!p_blackboard.is_valid(), p_default);
 
 	if (value_source == SAVED_VALUE) {
-		if (saved_value == Variant()) {
+		if (unlikely(saved_value.get_type() == Variant::NIL)) {
 			_assign_default_value();
 		}
 		return saved_value;
 	} else {
-		ERR_FAIL_COND_V_MSG(!p_blackboard->has_var(variable), p_default, vformat("BBParam: Blackboard variable \"%s\" doesn't exist.", variable));
+		// Single lookup: get_var() reports missing variables.
 		return p_blackboard->get_var(variable, p_default);
 	}
 }
 
+Variant BBParam::get_value_by_handle(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, BBHandle &r_handle, const Variant &p_default) {
+	if (value_source == SAVED_VALUE) {
+		return get_value(p_scene_root, p_blackboard, p_default);
+	}
+	ERR_FAIL_COND_V(!p_blackboard.is_valid(), p_default);
+	if (unlikely(r_handle.name != variable)) {
+		r_handle = BBHandle(variable);
+	}
+	return p_blackboard->get_var_by_handle(r_handle, p_default);
+}
+
+BBHandle BBParam::resolve_handle(const Ref<Blackboard> &p_blackboard) {
+	if (value_source == SAVED_VALUE) {
+		if (saved_value.get_type() == Variant::NIL) {
+			_assign_default_value();
+		}
+		return BBHandle();
+	}
+	ERR_FAIL_COND_V(!p_blackboard.is_valid(), BBHandle(variable));
+	return p_blackboard->resolve_var(variable);
+}
+
 void BBParam::_get_property_list(List<PropertyInfo> *p_list) const {
 	if (value_source == ValueSource::SAVED_VALUE) {
 		p_list->push_back(PropertyInfo(get_type(), "saved_value"));
@@ -67,6 +67,12 @@ public:
 	virtual Variant::Type get_type() const { return Variant::NIL; }
 	virtual Variant::Type get_variable_expected_type() const { return get_type(); }
 	virtual Variant get_value(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, const Variant &p_default = Variant());
+	// Same as get_value(), but blackboard variable is accessed using a handle owned by the caller.
+	// Handle is not stored in the parameter, as parameter resources may be shared between tasks.
+	virtual Variant get_value_by_handle(Node *p_scene_root, const Ref<Blackboard> &p_blackboard, BBHandle &r_handle, const Variant &p_default = Variant());
+	// Returns a handle for get_value_by_handle() that is resolved in advance (i.e., in BTTask::_setup()).
+	// Also assigns the default saved value if it is not set, so it doesn't happen during ticks.
+	BBHandle resolve_handle(const Ref<Blackboard> &p_blackboard);
 
 	BBParam();
 };
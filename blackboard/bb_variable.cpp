@@ -13,6 +13,11 @@
 
 #include "../util/limbo_compat.h"
 
+#ifdef LIMBOAI_MODULE
+#include "core/object/class_db.h"
+#include "core/object/method_bind.h"
+#endif // LIMBOAI_MODULE
+
 void BBVariable::unref() {
 	if (data && data->refcount.unref()) {
 		memdelete(data);
@@ -23,11 +28,27 @@ void BBVariable::unref() {
 void BBVariable::set_value(const Variant &p_value) {
 	data->value = p_value; // Setting value even when bound as a fallback in case the binding fails.
 	data->value_changed = true;
+	data->revision += 1;
 
 	if (is_bound()) {
 		Object *obj = OBJECT_DB_GET_INSTANCE(data->bound_object);
 		ERR_FAIL_COND_MSG(!obj, "Blackboard: Failed to get bound object.");
 #ifdef LIMBOAI_MODULE
+		if (likely(data->bound_setter)) {
+			Callable::CallError ce;
+			if (data->bound_index >= 0) {
+				const Variant index = data->bound_index;
+				const Variant *args[2] = { &index, &p_value };
+				data->bound_setter->call(obj, args, 2, ce);
+			} else {
+				const Variant *args[1] = { &p_value };
+				data->bound_setter->call(obj, args, 1, ce);
+			}
+			if (likely(ce.error == Callable::CallError::CALL_OK)) {
+				return;
+			}
+			// Fall through to report the error.
+		}
 		bool r_valid;
 		obj->set(data->bound_property, p_value, &r_valid);
 		ERR_FAIL_COND_MSG(!r_valid, vformat("Blackboard: Failed to set bound property `%s` on %s", data->bound_property, obj));
@@ -42,6 +63,20 @@ Variant BBVariable::get_value() const {
 		Object *obj = OBJECT_DB_GET_INSTANCE(data->bound_object);
 		ERR_FAIL_COND_V_MSG(!obj, data->value, "Blackboard: Failed to get bound object.");
 #ifdef LIMBOAI_MODULE
+		if (likely(data->bound_getter)) {
+			Callable::CallError ce;
+			Variant ret;
+			if (data->bound_index >= 0) {
+				const Variant index = data->bound_index;
+				const Variant *args[1] = { &index };
+				ret = data->bound_getter->call(obj, args, 1, ce);
+			} else {
+				ret = data->bound_getter->call(obj, nullptr, 0, ce);
+			}
+			if (likely(ce.error == Callable::CallError::CALL_OK)) {
+				return ret;
+			}
+		}
 		bool r_valid;
 		Variant ret = obj->get(data->bound_property, &r_valid);
 		ERR_FAIL_COND_V_MSG(!r_valid, data->value, vformat("Blackboard: Failed to get bound property `%s` on %s", data->bound_property, obj));
@@ -56,6 +91,7 @@ Variant BBVariable::get_value() const {
 void BBVariable::set_type(Variant::Type p_type) {
 	data->type = p_type;
 	data->value = VARIANT_DEFAULT(p_type);
+	data->revision += 1;
 }
 
 Variant::Type BBVariable::get_type() const {
@@ -91,6 +127,11 @@ BBVariable BBVariable::duplicate(bool p_deep) const {
 	var.data->binding_path = data->binding_path;
 	var.data->bound_object = data->bound_object;
 	var.data->bound_property = data->bound_property;
+#ifdef LIMBOAI_MODULE
+	var.data->bound_getter = data->bound_getter;
+	var.data->bound_setter = data->bound_setter;
+	var.data->bound_index = data->bound_index;
+#endif
 	return var;
 }
 
@@ -119,11 +160,32 @@ void BBVariable::bind(Object *p_object, const StringName &p_property) {
 	ERR_FAIL_COND_MSG(!OBJECT_HAS_PROPERTY(p_object, p_property), vformat("Blackboard: Binding failed - %s has no property `%s`.", p_object, p_property));
 	data->bound_object = p_object->get_instance_id();
 	data->bound_property = p_property;
+
+#ifdef LIMBOAI_MODULE
+	// Resolve accessors of native properties once, so that access doesn't need to look up the property by name.
+	// Script properties have no accessors in ClassDB and are still accessed by name.
+	data->bound_getter = nullptr;
+	data->bound_setter = nullptr;
+	data->bound_index = -1;
+	const StringName class_name = p_object->get_class_name();
+	const StringName getter = ClassDB::get_property_getter(class_name, p_property);
+	const StringName setter = ClassDB::get_property_setter(class_name, p_property);
+	if (getter != StringName() && setter != StringName()) {
+		data->bound_getter = ClassDB::get_method(class_name, getter);
+		data->bound_setter = ClassDB::get_method(class_name, setter);
+		data->bound_index = ClassDB::get_property_index(class_name, p_property);
+	}
+#endif
 }
 
 void BBVariable::unbind() {
 	data->bound_object = 0;
 	data->bound_property = StringName();
+#ifdef LIMBOAI_MODULE
+	data->bound_getter = nullptr;
+	data->bound_setter = nullptr;
+	data->bound_index = -1;
+#endif
 }
 
 bool BBVariable::operator==(const BBVariable &p_var) const {
@@ -14,6 +14,8 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/object/object.h"
+
+class MethodBind;
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
@@ -26,6 +28,8 @@ private:
 	struct Data {
 		// Is used to decide if the value needs to be synced in a derived plan.
 		bool value_changed = false;
+		// Incremented when the value or type is modified.
+		uint32_t revision = 0;
 
 		SafeRefCount refcount;
 		Variant value;
@@ -36,6 +40,12 @@ private:
 		NodePath binding_path;
 		uint64_t bound_object = 0;
 		StringName bound_property;
+#ifdef LIMBOAI_MODULE
+		// Accessors of the bound property, resolved once on binding (null if not a native property).
+		MethodBind *bound_getter = nullptr;
+		MethodBind *bound_setter = nullptr;
+		int bound_index = -1;
+#endif
 	};
 
 	Data *data = nullptr;
@@ -56,9 +66,16 @@ public:
 
 	BBVariable duplicate(bool p_deep = false) const;
 
+	// Returns true if the variable data is linked with other blackboards.
+	_FORCE_INLINE_ bool is_shared() const { return data->refcount.get() > 1; }
+
 	_FORCE_INLINE_ bool is_value_changed() const { return data->value_changed; }
 	_FORCE_INLINE_ void reset_value_changed() { data->value_changed = false; }
 
+	_FORCE_INLINE_ uint32_t get_revision() const { return data->revision; }
+	// Returns true if both variables refer to the same data.
+	_FORCE_INLINE_ bool is_same_data(const BBVariable &p_other) const { return data == p_other.data; }
+
 	bool is_same_prop_info(const BBVariable &p_other) const;
 	void copy_prop_info(const BBVariable &p_other);
 
@@ -11,19 +11,35 @@
 
 #include "blackboard.h"
 
+#include "shared_blackboard.h"
+
+#include "../util/limbo_compat.h"
+
 #ifdef LIMBOAI_MODULE
+#include "core/io/resource_loader.h"
+#include "core/templates/hash_set.h"
 #include "core/variant/variant.h"
 #include "scene/main/node.h"
+#include "scene/main/scene_tree.h"
+#include "scene/main/window.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/engine.hpp>
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/classes/resource_loader.hpp>
+#include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/window.hpp>
 #include <godot_cpp/core/object.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 using namespace godot;
 #endif
 
+thread_local BBReadRecorder *Blackboard::read_recorder = nullptr;
+SafeNumeric<uint64_t> Blackboard::scope_layout_epoch;
+
 Ref<Blackboard> Blackboard::top() const {
 	Ref<Blackboard> bb(this);
 	while (bb->get_parent().is_valid()) {
@@ -32,43 +48,307 @@ Ref<Blackboard> Blackboard::top() const {
 	return bb;
 }
 
-Variant Blackboard::get_var(const StringName &p_name, const Variant &p_default, bool p_complain) const {
-	if (data.has(p_name)) {
-		return data.get(p_name).get_value();
-	} else if (parent.is_valid()) {
-		return parent->get_var(p_name, p_default, p_complain);
+void Blackboard::set_parent(const Ref<Blackboard> &p_blackboard) {
+	parent = p_blackboard;
+	if (p_blackboard.is_valid()) {
+		p_blackboard->has_nested_scopes = true;
+	}
+	// Variables may now resolve to a different scope.
+	_layout_changed();
+}
+
+void Blackboard::_layout_changed() {
+	layout_version += 1;
+	// Nested scopes pick up changes of shared scopes when they are published.
+	if (unlikely(has_nested_scopes && !shared_scope)) {
+		scope_layout_epoch.increment();
+	}
+}
+
+uint32_t Blackboard::_add_slot(const StringName &p_name, const BBVariable &p_var) {
+	uint32_t idx;
+	if (free_slots.size() > 0) {
+		idx = free_slots[free_slots.size() - 1];
+		free_slots.resize(free_slots.size() - 1);
+		slots[idx] = p_var;
+		slot_infos[idx] = BBSlotInfo();
+	} else {
+		idx = slots.size();
+		slots.push_back(p_var);
+		slot_infos.push_back(BBSlotInfo());
+	}
+	slot_indices.insert(p_name, idx);
+	_layout_changed();
+	return idx;
+}
+
+void Blackboard::_reserve_slots(uint32_t p_count) {
+	slots.reserve(slots.size() + p_count);
+	slot_infos.reserve(slot_infos.size() + p_count);
+	slot_indices.reserve(slot_indices.size() + p_count);
+}
+
+BBScalarKind Blackboard::_get_scalar_kind(Variant::Type p_type) {
+	switch (p_type) {
+		case Variant::BOOL:
+			return BB_SCALAR_BOOL;
+		case Variant::INT:
+			return BB_SCALAR_INT;
+		case Variant::FLOAT:
+			return BB_SCALAR_FLOAT;
+		case Variant::VECTOR2:
+			return BB_SCALAR_VECTOR2;
+		case Variant::VECTOR3:
+			return BB_SCALAR_VECTOR3;
+		default:
+			return BB_SCALAR_NONE;
+	}
+}
+
+bool Blackboard::_assign_scalar(const StringName &p_name, const BBVariable &p_plan_var) {
+	const BBScalarKind kind = _get_scalar_kind(p_plan_var.get_type());
+	const Variant value = p_plan_var.get_value();
+	if (kind == BB_SCALAR_NONE || value.get_type() != p_plan_var.get_type()) {
+		return false;
+	}
+
+	BBSlotInfo ref;
+	ref.kind = kind;
+	switch (kind) {
+		case BB_SCALAR_BOOL: {
+			ref.index = scalars.bools.size();
+			scalars.bools.push_back(value);
+		} break;
+		case BB_SCALAR_INT: {
+			ref.index = scalars.ints.size();
+			scalars.ints.push_back(value);
+		} break;
+		case BB_SCALAR_FLOAT: {
+			ref.index = scalars.floats.size();
+			scalars.floats.push_back(value);
+		} break;
+		case BB_SCALAR_VECTOR2: {
+			ref.index = scalars.vector2s.size();
+			scalars.vector2s.push_back(value);
+		} break;
+		case BB_SCALAR_VECTOR3: {
+			ref.index = scalars.vector3s.size();
+			scalars.vector3s.push_back(value);
+		} break;
+		default: {
+		} break;
+	}
+
+	// The plan's variable is shared, not duplicated - it only provides the metadata.
+	HashMap<StringName, uint32_t>::Iterator E = slot_indices.find(p_name);
+	uint32_t idx;
+	if (E) {
+		idx = E->value;
+		slots[idx] = p_plan_var;
+	} else {
+		idx = _add_slot(p_name, p_plan_var);
+	}
+	ref.version = slot_infos[idx].version;
+	slot_infos[idx] = ref;
+	_var_changed(idx, p_name);
+	_bump_version();
+	return true;
+}
+
+Variant Blackboard::_get_scalar(uint32_t p_slot) const {
+	const BBSlotInfo &ref = slot_infos[p_slot];
+	switch (ref.kind) {
+		case BB_SCALAR_BOOL:
+			return scalars.bools[ref.index];
+		case BB_SCALAR_INT:
+			return scalars.ints[ref.index];
+		case BB_SCALAR_FLOAT:
+			return scalars.floats[ref.index];
+		case BB_SCALAR_VECTOR2:
+			return scalars.vector2s[ref.index];
+		case BB_SCALAR_VECTOR3:
+			return scalars.vector3s[ref.index];
+		default:
+			return Variant();
+	}
+}
+
+bool Blackboard::_set_scalar(uint32_t p_slot, const Variant &p_value) {
+	const BBSlotInfo &ref = slot_infos[p_slot];
+	if (_get_scalar_kind(p_value.get_type()) != ref.kind) {
+		// Duck-typing: the variable will hold a value of another type.
+		return false;
+	}
+	switch (ref.kind) {
+		case BB_SCALAR_BOOL: {
+			scalars.bools[ref.index] = p_value;
+		} break;
+		case BB_SCALAR_INT: {
+			scalars.ints[ref.index] = p_value;
+		} break;
+		case BB_SCALAR_FLOAT: {
+			scalars.floats[ref.index] = p_value;
+		} break;
+		case BB_SCALAR_VECTOR2: {
+			scalars.vector2s[ref.index] = p_value;
+		} break;
+		case BB_SCALAR_VECTOR3: {
+			scalars.vector3s[ref.index] = p_value;
+		} break;
+		default: {
+			return false;
+		}
+	}
+	return true;
+}
+
+void Blackboard::_assign_shared(const StringName &p_name, const BBVariable &p_snapshot_var) {
+	BBSlotInfo info;
+	info.shared = true;
+	HashMap<StringName, uint32_t>::Iterator E = slot_indices.find(p_name);
+	uint32_t idx;
+	if (E) {
+		idx = E->value;
+		slots[idx] = p_snapshot_var;
 	} else {
-		if (p_complain) {
-			ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", p_name));
+		idx = _add_slot(p_name, p_snapshot_var);
+	}
+	info.version = slot_infos[idx].version;
+	slot_infos[idx] = info;
+	_var_changed(idx, p_name);
+	_bump_version();
+}
+
+Variant Blackboard::_get_unowned_value(uint32_t p_slot) const {
+	if (_is_scalar(p_slot)) {
+		return _get_scalar(p_slot);
+	}
+	Variant value = slots[p_slot].get_value();
+	if (value.get_type() == Variant::ARRAY || value.get_type() == Variant::DICTIONARY) {
+		// Reference types can be modified in place by the caller, so the blackboard needs its own copy.
+		Blackboard *self = const_cast<Blackboard *>(this);
+		self->_make_owned(p_slot);
+		return self->slots[p_slot].get_value();
+	}
+	return value;
+}
+
+void Blackboard::_make_owned(uint32_t p_slot, bool p_copy_value) {
+	// Note: Scalar values stay allocated in the scalar block until the blackboard is cleared.
+	BBVariable var = slots[p_slot].duplicate(p_copy_value);
+	if (_is_scalar(p_slot)) {
+		var.set_value(_get_scalar(p_slot));
+	}
+	slots[p_slot] = var;
+	BBSlotInfo info;
+	info.version = slot_infos[p_slot].version;
+	slot_infos[p_slot] = info;
+}
+
+Variant Blackboard::get_var(const StringName &p_name, const Variant &p_default, bool p_complain) const {
+	_record_read(p_name);
+	for (const Blackboard *bb = this; bb; bb = bb->parent.ptr()) {
+		if (unlikely(bb->shared_scope && bb != this)) {
+			// Nested scopes read the published snapshot.
+			const SharedBlackboard::ReadLock lock(static_cast<const SharedBlackboard *>(bb));
+			const SharedBlackboard::SnapshotVar *var = lock.get_var(p_name);
+			if (var) {
+				return var->value;
+			}
+			continue;
+		}
+		HashMap<StringName, uint32_t>::ConstIterator E = bb->slot_indices.find(p_name);
+		if (E) {
+			return bb->_get_slot_value(E->value);
 		}
-		return p_default;
 	}
+	if (p_complain) {
+		ERR_PRINT(vformat("Blackboard: Variable \"%s\" not found.", p_name));
+	}
+	return p_default;
 }
 
 void Blackboard::set_var(const StringName &p_name, const Variant &p_value) {
-	if (data.has(p_name)) {
+	_set_local_var(p_name, p_value);
+}
+
+uint32_t Blackboard::_set_local_var(const StringName &p_name, const Variant &p_value) {
+	HashMap<StringName, uint32_t>::Iterator E = slot_indices.find(p_name);
+	uint32_t idx;
+	if (E) {
 		// Not checking type - allowing duck-typing.
-		data[p_name].set_value(p_value);
+		idx = E->value;
+		_set_slot_value(idx, p_value);
 	} else {
-		BBVariable var(p_value.get_type());
-		var.set_value(p_value);
-		data.insert(p_name, var);
+		BBVariable new_var(p_value.get_type());
+		new_var.set_value(p_value);
+		idx = _add_slot(p_name, new_var);
 	}
+	_var_changed(idx, p_name);
+	_bump_version();
+	return idx;
+}
+
+void Blackboard::_set_var_by_handle_slow(BBHandle &r_handle, const Variant &p_value) {
+	// Variables of parent scopes are shadowed by a local variable, just like in set_var().
+	// The handle is rebound to the local variable directly, without resolving the whole chain.
+	r_handle.slot = _set_local_var(r_handle.name, p_value);
+	r_handle.origin = this;
+	r_handle.target = Ref<Blackboard>(this);
+	r_handle.layout = _get_chain_layout();
+	r_handle.published = false;
 }
 
 bool Blackboard::has_var(const StringName &p_name) const {
-	return data.has(p_name) || (parent.is_valid() && parent->has_var(p_name));
+	for (const Blackboard *bb = this; bb; bb = bb->parent.ptr()) {
+		if (unlikely(bb->shared_scope && bb != this)) {
+			if (static_cast<const SharedBlackboard *>(bb)->has_published_var(p_name)) {
+				return true;
+			}
+			continue;
+		}
+		if (bb->slot_indices.has(p_name)) {
+			return true;
+		}
+	}
+	return false;
 }
 
 void Blackboard::erase_var(const StringName &p_name) {
-	data.erase(p_name);
+	HashMap<StringName, uint32_t>::Iterator E = slot_indices.find(p_name);
+	if (E) {
+		// Release the variable data, but keep the slot for reuse.
+		const uint32_t idx = E->value;
+		slots[idx] = BBVariable();
+		slot_infos[idx] = BBSlotInfo();
+		free_slots.push_back(idx);
+		slot_indices.erase(p_name);
+		_layout_changed();
+		if (unlikely(shared_scope)) {
+			static_cast<SharedBlackboard *>(this)->_queue_publish();
+		}
+	}
+	_bump_version();
+}
+
+void Blackboard::clear() {
+	slots.clear();
+	slot_infos.clear();
+	scalars.clear();
+	free_slots.clear();
+	slot_indices.clear();
+	_layout_changed();
+	if (unlikely(shared_scope)) {
+		static_cast<SharedBlackboard *>(this)->_queue_publish();
+	}
+	_bump_version();
 }
 
 TypedArray<StringName> Blackboard::list_vars() const {
 	TypedArray<StringName> var_names;
-	var_names.resize(data.size());
+	var_names.resize(slot_indices.size());
 	int idx = 0;
-	for (const KeyValue<StringName, BBVariable> &kv : data) {
+	for (const KeyValue<StringName, uint32_t> &kv : slot_indices) {
 		var_names[idx] = kv.key;
 		idx += 1;
 	}
@@ -77,8 +357,8 @@ TypedArray<StringName> Blackboard::list_vars() const {
 
 Dictionary Blackboard::get_vars_as_dict() const {
 	Dictionary dict;
-	for (const KeyValue<StringName, BBVariable> &kv : data) {
-		dict[kv.key] = kv.value.get_value();
+	for (const KeyValue<StringName, uint32_t> &kv : slot_indices) {
+		dict[kv.key] = _get_slot_value(kv.value);
 	}
 	return dict;
 }
@@ -94,37 +374,609 @@ void Blackboard::populate_from_dict(const Dictionary &p_dictionary) {
 	}
 }
 
+Array Blackboard::get_vars(const TypedArray<StringName> &p_names, const Variant &p_default) const {
+	Array values;
+	values.resize(p_names.size());
+	for (int i = 0; i < p_names.size(); i++) {
+		values[i] = get_var(p_names[i], p_default);
+	}
+	return values;
+}
+
+void Blackboard::set_vars(const TypedArray<StringName> &p_names, const Array &p_values) {
+	ERR_FAIL_COND_MSG(p_names.size() != p_values.size(), "Blackboard: Number of names and values must match.");
+	bool changed = false;
+	for (int i = 0; i < p_names.size(); i++) {
+		const StringName name = p_names[i];
+		HashMap<StringName, uint32_t>::Iterator E = slot_indices.find(name);
+		if (unlikely(!E)) {
+			set_var(name, p_values[i]);
+			continue;
+		}
+		_set_slot_value(E->value, p_values[i]);
+		_var_changed(E->value, name);
+		changed = true;
+	}
+	if (changed) {
+		_bump_version();
+	}
+}
+
+template <typename T, typename TArray>
+void Blackboard::_set_vars_from_packed(const TypedArray<StringName> &p_names, const TArray &p_values) {
+	ERR_FAIL_COND_MSG(p_names.size() != p_values.size(), "Blackboard: Number of names and values must match.");
+	const T *values = p_values.ptr();
+	bool changed = false;
+	for (int i = 0; i < p_names.size(); i++) {
+		const StringName name = p_names[i];
+		HashMap<StringName, uint32_t>::Iterator E = slot_indices.find(name);
+		if (unlikely(!E)) {
+			set_var(name, values[i]);
+			continue;
+		}
+		const BBSlotInfo &info = slot_infos[E->value];
+		if (likely(info.kind == BBScalarTraits<T>::KIND)) {
+			BBScalarTraits<T>::get_array(scalars)[info.index] = values[i];
+		} else {
+			_set_slot_value(E->value, values[i]);
+		}
+		_var_changed(E->value, name);
+		changed = true;
+	}
+	if (changed) {
+		_bump_version();
+	}
+}
+
+template <typename T, typename TArray>
+TArray Blackboard::_get_vars_as_packed(const TypedArray<StringName> &p_names) const {
+	TArray result;
+	result.resize(p_names.size());
+	T *values = result.ptrw();
+	for (int i = 0; i < p_names.size(); i++) {
+		const StringName name = p_names[i];
+		HashMap<StringName, uint32_t>::ConstIterator E = slot_indices.find(name);
+		if (likely(E)) {
+			_record_read(name);
+			const BBSlotInfo &info = slot_infos[E->value];
+			values[i] = likely(info.kind == BBScalarTraits<T>::KIND) ? BBScalarTraits<T>::get_array(scalars)[info.index] : T(_get_slot_value(E->value));
+		} else {
+			values[i] = get_var(name, T());
+		}
+	}
+	return result;
+}
+
+PackedFloat64Array Blackboard::get_vars_as_floats(const TypedArray<StringName> &p_names) const {
+	return _get_vars_as_packed<double, PackedFloat64Array>(p_names);
+}
+
+void Blackboard::set_vars_from_floats(const TypedArray<StringName> &p_names, const PackedFloat64Array &p_values) {
+	_set_vars_from_packed<double>(p_names, p_values);
+}
+
+PackedInt64Array Blackboard::get_vars_as_ints(const TypedArray<StringName> &p_names) const {
+	return _get_vars_as_packed<int64_t, PackedInt64Array>(p_names);
+}
+
+void Blackboard::set_vars_from_ints(const TypedArray<StringName> &p_names, const PackedInt64Array &p_values) {
+	_set_vars_from_packed<int64_t>(p_names, p_values);
+}
+
+void Blackboard::set_vars_by_handles(BBHandle *r_handles, const Variant *p_values, uint32_t p_count) {
+	bool changed = false;
+	for (uint32_t i = 0; i < p_count; i++) {
+		BBHandle &handle = r_handles[i];
+		if (unlikely(!is_handle_valid(handle) || handle.target.ptr() != this)) {
+			set_var(handle.name, p_values[i]);
+			handle = resolve_var(handle.name);
+			continue;
+		}
+		_set_slot_value(handle.slot, p_values[i]);
+		_var_changed(handle.slot, handle.name);
+		changed = true;
+	}
+	if (changed) {
+		_bump_version();
+	}
+}
+
 void Blackboard::bind_var_to_property(const StringName &p_name, Object *p_object, const StringName &p_property, bool p_create) {
-	if (!data.has(p_name)) {
+	BBVariable *var = _get_local(p_name);
+	if (!var) {
 		if (p_create) {
-			data.insert(p_name, BBVariable());
+			var = &slots[_add_slot(p_name, BBVariable())];
 		} else {
 			ERR_FAIL_MSG("Blackboard: Can't bind variable that doesn't exist (var: " + p_name + ").");
 		}
 	}
-	data[p_name].bind(p_object, p_property);
+	var->bind(p_object, p_property);
+	binding_version += 1;
+	_var_changed(slot_indices[p_name], p_name);
+	_bump_version();
 }
 
 void Blackboard::unbind_var(const StringName &p_name) {
-	ERR_FAIL_COND_MSG(!data.has(p_name), "Blackboard: Can't unbind variable that doesn't exist (var: " + p_name + ").");
-	data[p_name].unbind();
+	BBVariable *var = _get_local(p_name);
+	ERR_FAIL_NULL_MSG(var, "Blackboard: Can't unbind variable that doesn't exist (var: " + p_name + ").");
+	var->unbind();
+	binding_version += 1;
+	_var_changed(slot_indices[p_name], p_name);
+	_bump_version();
 }
 
 void Blackboard::assign_var(const StringName &p_name, const BBVariable &p_var) {
-	data.insert(p_name, p_var);
+	HashMap<StringName, uint32_t>::Iterator E = slot_indices.find(p_name);
+	uint32_t idx;
+	if (E) {
+		idx = E->value;
+		slots[idx] = p_var;
+		BBSlotInfo info;
+		info.version = slot_infos[idx].version;
+		slot_infos[idx] = info;
+	} else {
+		idx = _add_slot(p_name, p_var);
+	}
+	binding_version += 1;
+	_var_changed(idx, p_name);
+	_bump_version();
 }
 
 void Blackboard::link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create) {
-	if (!data.has(p_name)) {
+	BBVariable *var = _get_local(p_name);
+	if (!var) {
 		if (p_create) {
-			data.insert(p_name, BBVariable());
+			var = &slots[_add_slot(p_name, BBVariable())];
 		} else {
 			ERR_FAIL_MSG("Blackboard: Can't link variable that doesn't exist (var: " + p_name + ").");
 		}
 	}
 	ERR_FAIL_COND_MSG(p_target_blackboard.is_null(), "Blackboard: Can't link variable to target blackboard that is null (var: " + p_name + ").");
-	ERR_FAIL_COND_MSG(!p_target_blackboard->data.has(p_target_var), "Blackboard: Can't link variable to non-existent target (var: " + p_name + ", target: " + p_target_var + ").");
-	data[p_name] = p_target_blackboard->data[p_target_var];
+	// Converts the target to a regular variable if it's a scalar, so that the data can be shared.
+	const BBVariable *target_var = p_target_blackboard->_get_local(p_target_var);
+	ERR_FAIL_NULL_MSG(target_var, "Blackboard: Can't link variable to non-existent target (var: " + p_name + ", target: " + p_target_var + ").");
+	*var = *target_var;
+	binding_version += 1;
+	_var_changed(slot_indices[p_name], p_name);
+	_bump_version();
+}
+
+bool Blackboard::is_isolated() const {
+	// Shared scopes are only read through immutable snapshots.
+	for (const Blackboard *bb = parent.ptr(); bb; bb = bb->parent.ptr()) {
+		if (!bb->shared_scope) {
+			return false;
+		}
+	}
+	for (const KeyValue<StringName, uint32_t> &kv : slot_indices) {
+		if (!_is_owned(kv.value)) {
+			continue; // Plan data is only shared until modified.
+		}
+		const BBVariable &var = slots[kv.value];
+		if (var.is_bound() || var.is_shared()) {
+			return false;
+		}
+	}
+	return true;
+}
+
+uint64_t Blackboard::get_isolation_version() const {
+	uint64_t isolation_version = 0;
+	for (const Blackboard *bb = this; bb; bb = bb->parent.ptr()) {
+		isolation_version += bb->layout_version + bb->binding_version;
+	}
+	return isolation_version;
+}
+
+uint64_t Blackboard::get_scope_version() const {
+	uint64_t scope_version = version;
+	for (const Blackboard *bb = parent.ptr(); bb; bb = bb->parent.ptr()) {
+		scope_version += bb->version;
+	}
+	return scope_version;
+}
+
+uint32_t Blackboard::get_var_version(const StringName &p_name) const {
+	for (const Blackboard *bb = this; bb; bb = bb->parent.ptr()) {
+		if (unlikely(bb->shared_scope && bb != this)) {
+			const SharedBlackboard::ReadLock lock(static_cast<const SharedBlackboard *>(bb));
+			const SharedBlackboard::SnapshotVar *var = lock.get_var(p_name);
+			if (var) {
+				return var->version;
+			}
+			continue;
+		}
+		HashMap<StringName, uint32_t>::ConstIterator E = bb->slot_indices.find(p_name);
+		if (E) {
+			return bb->slot_infos[E->value].version;
+		}
+	}
+	return 0;
+}
+
+void Blackboard::watch_var(const StringName &p_name, const Callable &p_callable) {
+	ERR_FAIL_COND_MSG(!p_callable.is_valid(), "Blackboard: Can't watch variable with an invalid callable (var: " + p_name + ").");
+	LocalVector<Callable> &callables = watchers[p_name];
+	ERR_FAIL_COND_MSG(callables.has(p_callable), "Blackboard: Callable is already watching variable (var: " + p_name + ").");
+	callables.push_back(p_callable);
+	notify_changes = true;
+}
+
+void Blackboard::unwatch_var(const StringName &p_name, const Callable &p_callable) {
+	HashMap<StringName, LocalVector<Callable>>::Iterator E = watchers.find(p_name);
+	ERR_FAIL_COND_MSG(!E || !E->value.has(p_callable), "Blackboard: Callable is not watching variable (var: " + p_name + ").");
+	E->value.erase(p_callable);
+	if (E->value.is_empty()) {
+		watchers.erase(p_name);
+	}
+	notify_changes = shared_scope || !watchers.is_empty();
+}
+
+void Blackboard::_notify_var_changed(const StringName &p_name) {
+	if (!watchers.is_empty()) {
+		_queue_change(p_name);
+	}
+	if (shared_scope) {
+		static_cast<SharedBlackboard *>(this)->_queue_publish();
+	}
+}
+
+void Blackboard::_queue_change(const StringName &p_name) {
+	if (!watchers.has(p_name) || pending_changes.has(p_name)) {
+		return;
+	}
+	pending_changes.push_back(p_name);
+	if (!flush_queued) {
+		flush_queued = true;
+		// Keeps the blackboard alive until the deferred call is made.
+		callable_mp_static(&Blackboard::_flush_deferred).bind(Ref<Blackboard>(this)).call_deferred();
+	}
+}
+
+void Blackboard::_flush_deferred(const Ref<Blackboard> &p_blackboard) {
+	if (p_blackboard->flush_queued) {
+		p_blackboard->flush_watchers();
+	}
+}
+
+void Blackboard::flush_watchers() {
+	flush_queued = false;
+	// Changes made by the watchers are queued for the next flush.
+	LocalVector<StringName> changes = pending_changes;
+	pending_changes.clear();
+	for (const StringName &name : changes) {
+		HashMap<StringName, LocalVector<Callable>>::ConstIterator E = watchers.find(name);
+		if (!E) {
+			continue;
+		}
+		const LocalVector<Callable> callables = E->value;
+		const Variant value = get_var(name, Variant(), false);
+		for (const Callable &callable : callables) {
+			callable.call(name, value);
+		}
+	}
+}
+
+Variant Blackboard::_get_published_value(const BBHandle &p_handle, const Variant &p_default, bool p_complain) const {
+	const SharedBlackboard::ReadLock lock(static_cast<const SharedBlackboard *>(p_handle.target.ptr()));
+	const SharedBlackboard::SnapshotVar *var = lock.get_var(p_handle.name);
+	if (likely(var)) {
+		return var->value;
+	}
+	// Snapshot was replaced after the handle was validated.
+	return get_var(p_handle.name, p_default, p_complain);
+}
+
+uint32_t Blackboard::_get_published_version(const BBHandle &p_handle) const {
+	const SharedBlackboard::ReadLock lock(static_cast<const SharedBlackboard *>(p_handle.target.ptr()));
+	const SharedBlackboard::SnapshotVar *var = lock.get_var(p_handle.name);
+	return var ? var->version : get_var_version(p_handle.name);
+}
+
+bool Blackboard::is_var_version_tracked_by_handle(BBHandle &r_handle) const {
+	if (unlikely(!is_handle_valid(r_handle))) {
+		r_handle = resolve_var(r_handle.name);
+		if (!r_handle.is_resolved()) {
+			return true;
+		}
+	}
+	if (unlikely(r_handle.published)) {
+		const SharedBlackboard::ReadLock lock(static_cast<const SharedBlackboard *>(r_handle.target.ptr()));
+		const SharedBlackboard::SnapshotVar *var = lock.get_var(r_handle.name);
+		return !var || var->version_tracked;
+	}
+	return r_handle.target->_is_version_tracked(r_handle.slot);
+}
+
+void Blackboard::push_read_recorder(BBReadRecorder *p_recorder) {
+	ERR_FAIL_NULL(p_recorder);
+	p_recorder->outer = read_recorder;
+	read_recorder = p_recorder;
+}
+
+void Blackboard::pop_read_recorder() {
+	ERR_FAIL_NULL(read_recorder);
+	read_recorder = read_recorder->outer;
+}
+
+BBHandle Blackboard::resolve_var(const StringName &p_name) const {
+	BBHandle handle(p_name);
+	handle.origin = this;
+	// Taken before the lookup, so that concurrent changes of parent scopes invalidate the handle.
+	handle.layout = _get_chain_layout();
+	for (const Blackboard *bb = this; bb; bb = bb->parent.ptr()) {
+		if (unlikely(bb->shared_scope && bb != this)) {
+			if (static_cast<const SharedBlackboard *>(bb)->has_published_var(p_name)) {
+				// Shared scopes can't be accessed by slot - the handle reads the published snapshot.
+				handle.target = Ref<Blackboard>(const_cast<Blackboard *>(bb));
+				handle.published = true;
+				break;
+			}
+			continue;
+		}
+		HashMap<StringName, uint32_t>::ConstIterator E = bb->slot_indices.find(p_name);
+		if (E) {
+			handle.target = Ref<Blackboard>(const_cast<Blackboard *>(bb));
+			handle.slot = E->value;
+			break;
+		}
+	}
+	return handle;
+}
+
+// * State serialization
+//
+// Format (little-endian, as written by StreamPeer):
+//   u32 scope_count, then for each scope: u32 var_count, then for each variable:
+//   utf8 name, u8 tag, payload (depends on tag; see BBStateTag).
+// Scalars are written directly from unboxed storage. Nodes are stored as absolute paths in the
+// scene tree, and resources as their file paths, so that they can be restored in a new session.
+// Other objects can't be saved.
+
+enum BBStateTag : uint8_t {
+	BB_STATE_NIL,
+	BB_STATE_BOOL,
+	BB_STATE_INT,
+	BB_STATE_FLOAT,
+	BB_STATE_VECTOR2,
+	BB_STATE_VECTOR3,
+	BB_STATE_NODE,
+	BB_STATE_VARIANT,
+	BB_STATE_RESOURCE,
+	BB_STATE_MAX
+};
+
+// Minimum payload size of each tag, used to detect truncated data.
+static const int bb_state_payload_size[BB_STATE_MAX] = { 0, 1, 8, 8, 16, 24, 4, 4, 4 };
+
+#define BB_STATE_FAIL_IF_TRUNCATED(m_bytes) \
+	ERR_FAIL_COND_V_MSG(p_stream->get_available_bytes() < (m_bytes), ERR_FILE_EOF, "Blackboard: State data is truncated.")
+
+void Blackboard::_save_scope(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_u32(slot_indices.size());
+	for (const KeyValue<StringName, uint32_t> &kv : slot_indices) {
+		p_stream->put_utf8_string(kv.key);
+		const BBSlotInfo &info = slot_infos[kv.value];
+		switch (info.kind) {
+			case BB_SCALAR_BOOL: {
+				p_stream->put_u8(BB_STATE_BOOL);
+				p_stream->put_u8(scalars.bools[info.index]);
+				continue;
+			}
+			case BB_SCALAR_INT: {
+				p_stream->put_u8(BB_STATE_INT);
+				p_stream->put_64(scalars.ints[info.index]);
+				continue;
+			}
+			case BB_SCALAR_FLOAT: {
+				p_stream->put_u8(BB_STATE_FLOAT);
+				p_stream->put_double(scalars.floats[info.index]);
+				continue;
+			}
+			case BB_SCALAR_VECTOR2: {
+				const Vector2 &v = scalars.vector2s[info.index];
+				p_stream->put_u8(BB_STATE_VECTOR2);
+				p_stream->put_double(v.x);
+				p_stream->put_double(v.y);
+				continue;
+			}
+			case BB_SCALAR_VECTOR3: {
+				const Vector3 &v = scalars.vector3s[info.index];
+				p_stream->put_u8(BB_STATE_VECTOR3);
+				p_stream->put_double(v.x);
+				p_stream->put_double(v.y);
+				p_stream->put_double(v.z);
+				continue;
+			}
+			default: {
+			} break;
+		}
+
+		const Variant value = _get_slot_value(kv.value);
+		switch (value.get_type()) {
+			case Variant::NIL: {
+				p_stream->put_u8(BB_STATE_NIL);
+			} break;
+			case Variant::BOOL: {
+				p_stream->put_u8(BB_STATE_BOOL);
+				p_stream->put_u8(bool(value));
+			} break;
+			case Variant::INT: {
+				p_stream->put_u8(BB_STATE_INT);
+				p_stream->put_64(value);
+			} break;
+			case Variant::FLOAT: {
+				p_stream->put_u8(BB_STATE_FLOAT);
+				p_stream->put_double(value);
+			} break;
+			case Variant::OBJECT: {
+				Object *obj = value;
+				Node *node = Object::cast_to<Node>(obj);
+				Resource *res = Object::cast_to<Resource>(obj);
+				if (node && node->is_inside_tree()) {
+					p_stream->put_u8(BB_STATE_NODE);
+					p_stream->put_utf8_string(String(node->get_path()));
+				} else if (res && !res->get_path().is_empty() && res->get_path().find("::") == -1) {
+					p_stream->put_u8(BB_STATE_RESOURCE);
+					p_stream->put_utf8_string(res->get_path());
+				} else {
+					if (obj) {
+						ERR_PRINT(vformat("Blackboard: Can't save variable \"%s\" - only nodes inside the scene tree and resources saved to a file can be saved. Saving null instead.", kv.key));
+					}
+					p_stream->put_u8(BB_STATE_NIL);
+				}
+			} break;
+			default: {
+				p_stream->put_u8(BB_STATE_VARIANT);
+				p_stream->put_var(value, false);
+			} break;
+		}
+	}
+}
+
+Error Blackboard::_read_scope(const Ref<StreamPeer> &p_stream, LocalVector<StateVar> &r_vars) {
+	BB_STATE_FAIL_IF_TRUNCATED(4);
+	const uint32_t var_count = p_stream->get_u32();
+	// Each variable takes at least 5 bytes (name length and tag).
+	BB_STATE_FAIL_IF_TRUNCATED(int64_t(var_count) * 5);
+	r_vars.resize(var_count);
+	for (uint32_t i = 0; i < var_count; i++) {
+		StateVar &var = r_vars[i];
+		BB_STATE_FAIL_IF_TRUNCATED(5);
+		var.name = p_stream->get_utf8_string();
+		ERR_FAIL_COND_V_MSG(var.name == StringName(), ERR_FILE_CORRUPT, "Blackboard: Invalid variable name in state data.");
+		BB_STATE_FAIL_IF_TRUNCATED(1);
+		var.tag = p_stream->get_u8();
+		ERR_FAIL_COND_V_MSG(var.tag >= BB_STATE_MAX, ERR_INVALID_DATA, vformat("Blackboard: Invalid state data for variable \"%s\".", var.name));
+		BB_STATE_FAIL_IF_TRUNCATED(bb_state_payload_size[var.tag]);
+		switch (var.tag) {
+			case BB_STATE_NIL: {
+			} break;
+			case BB_STATE_BOOL: {
+				var.value = p_stream->get_u8() != 0;
+			} break;
+			case BB_STATE_INT: {
+				var.value = p_stream->get_64();
+			} break;
+			case BB_STATE_FLOAT: {
+				var.value = p_stream->get_double();
+			} break;
+			case BB_STATE_VECTOR2: {
+				Vector2 v;
+				v.x = p_stream->get_double();
+				v.y = p_stream->get_double();
+				var.value = v;
+			} break;
+			case BB_STATE_VECTOR3: {
+				Vector3 v;
+				v.x = p_stream->get_double();
+				v.y = p_stream->get_double();
+				v.z = p_stream->get_double();
+				var.value = v;
+			} break;
+			case BB_STATE_NODE: {
+				const String path = p_stream->get_utf8_string();
+				ERR_FAIL_COND_V_MSG(path.is_empty(), ERR_FILE_CORRUPT, vformat("Blackboard: Invalid node path for variable \"%s\".", var.name));
+				var.value = path;
+			} break;
+			case BB_STATE_RESOURCE: {
+				const String path = p_stream->get_utf8_string();
+				ERR_FAIL_COND_V_MSG(path.is_empty(), ERR_FILE_CORRUPT, vformat("Blackboard: Invalid resource path for variable \"%s\".", var.name));
+				var.value = path;
+			} break;
+			case BB_STATE_VARIANT: {
+				var.value = p_stream->get_var(false);
+			} break;
+		}
+	}
+	return OK;
+}
+
+void Blackboard::_apply_scope(const LocalVector<StateVar> &p_vars) {
+	// * Restored scope contains exactly the saved variables.
+	HashSet<StringName> saved;
+	for (const StateVar &var : p_vars) {
+		saved.insert(var.name);
+	}
+	LocalVector<StringName> missing;
+	for (const KeyValue<StringName, uint32_t> &kv : slot_indices) {
+		if (!saved.has(kv.key)) {
+			missing.push_back(kv.key);
+		}
+	}
+	for (const StringName &name : missing) {
+		erase_var(name);
+	}
+
+	for (const StateVar &var : p_vars) {
+		switch (var.tag) {
+			case BB_STATE_NODE: {
+				const NodePath path = String(var.value);
+				SceneTree *tree = SCENE_TREE();
+				Node *node = (tree && tree->get_root()) ? tree->get_root()->get_node_or_null(path) : nullptr;
+				if (node == nullptr) {
+					ERR_PRINT(vformat("Blackboard: Node \"%s\" for variable \"%s\" not found. Using null instead.", path, var.name));
+				}
+				set_var(var.name, node);
+			} break;
+			case BB_STATE_RESOURCE: {
+				set_var(var.name, RESOURCE_LOAD(String(var.value), ""));
+			} break;
+			default: {
+				set_var(var.name, var.value);
+			} break;
+		}
+	}
+}
+
+#undef BB_STATE_FAIL_IF_TRUNCATED
+
+void Blackboard::save_state(const Ref<StreamPeer> &p_stream, bool p_include_parent_scopes) const {
+	ERR_FAIL_COND(p_stream.is_null());
+	// Shared scopes are not part of the agent's state, so they are skipped.
+	LocalVector<const Blackboard *> scopes;
+	for (const Blackboard *bb = this; bb; bb = p_include_parent_scopes ? bb->parent.ptr() : nullptr) {
+		if (!bb->shared_scope || bb == this) {
+			scopes.push_back(bb);
+		}
+	}
+	p_stream->put_u32(scopes.size());
+	for (const Blackboard *bb : scopes) {
+		bb->_save_scope(p_stream);
+	}
+}
+
+Error Blackboard::load_state(const Ref<StreamPeer> &p_stream) {
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_stream->get_available_bytes() < 4, ERR_FILE_EOF, "Blackboard: State data is truncated.");
+	const uint32_t scope_count = p_stream->get_u32();
+	// Each scope takes at least 4 bytes (variable count).
+	ERR_FAIL_COND_V_MSG(p_stream->get_available_bytes() < int64_t(scope_count) * 4, ERR_FILE_EOF, "Blackboard: State data is truncated.");
+
+	// * All data is read and validated first, so that corrupt data leaves the blackboard unchanged.
+	LocalVector<LocalVector<StateVar>> scope_vars;
+	LocalVector<Blackboard *> targets;
+	scope_vars.resize(scope_count);
+	Blackboard *bb = this;
+	for (uint32_t i = 0; i < scope_count; i++) {
+		while (bb && bb->shared_scope && bb != this) {
+			bb = bb->parent.ptr();
+		}
+		Error err = _read_scope(p_stream, scope_vars[i]);
+		ERR_FAIL_COND_V(err != OK, err);
+		// Scopes missing from the current chain are read, but not applied.
+		targets.push_back(bb);
+		if (bb) {
+			bb = bb->parent.ptr();
+		}
+	}
+
+	for (uint32_t i = 0; i < scope_count; i++) {
+		if (targets[i]) {
+			targets[i]->_apply_scope(scope_vars[i]);
+		}
+	}
+	return OK;
 }
 
 void Blackboard::_bind_methods() {
@@ -138,8 +990,21 @@ void Blackboard::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("list_vars"), &Blackboard::list_vars);
 	ClassDB::bind_method(D_METHOD("get_vars_as_dict"), &Blackboard::get_vars_as_dict);
 	ClassDB::bind_method(D_METHOD("populate_from_dict", "dictionary"), &Blackboard::populate_from_dict);
+	ClassDB::bind_method(D_METHOD("get_vars", "var_names", "default"), &Blackboard::get_vars, DEFVAL(Variant()));
+	ClassDB::bind_method(D_METHOD("set_vars", "var_names", "values"), &Blackboard::set_vars);
+	ClassDB::bind_method(D_METHOD("get_vars_as_floats", "var_names"), &Blackboard::get_vars_as_floats);
+	ClassDB::bind_method(D_METHOD("set_vars_from_floats", "var_names", "values"), &Blackboard::set_vars_from_floats);
+	ClassDB::bind_method(D_METHOD("get_vars_as_ints", "var_names"), &Blackboard::get_vars_as_ints);
+	ClassDB::bind_method(D_METHOD("set_vars_from_ints", "var_names", "values"), &Blackboard::set_vars_from_ints);
 	ClassDB::bind_method(D_METHOD("top"), &Blackboard::top);
 	ClassDB::bind_method(D_METHOD("bind_var_to_property", "var_name", "object", "property", "create"), &Blackboard::bind_var_to_property, DEFVAL(false));
 	ClassDB::bind_method(D_METHOD("unbind_var", "var_name"), &Blackboard::unbind_var);
 	ClassDB::bind_method(D_METHOD("link_var", "var_name", "target_blackboard", "target_var", "create"), &Blackboard::link_var, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("get_version"), &Blackboard::get_version);
+	ClassDB::bind_method(D_METHOD("get_var_version", "var_name"), &Blackboard::get_var_version);
+	ClassDB::bind_method(D_METHOD("watch_var", "var_name", "callable"), &Blackboard::watch_var);
+	ClassDB::bind_method(D_METHOD("unwatch_var", "var_name", "callable"), &Blackboard::unwatch_var);
+	ClassDB::bind_method(D_METHOD("flush_watchers"), &Blackboard::flush_watchers);
+	ClassDB::bind_method(D_METHOD("save_state", "stream", "include_parent_scopes"), &Blackboard::save_state, DEFVAL(false));
+	ClassDB::bind_method(D_METHOD("load_state", "stream"), &Blackboard::load_state);
 }
@@ -16,7 +16,10 @@
 
 #ifdef LIMBOAI_MODULE
 #include "core/object/object.h"
+#include "core/io/stream_peer.h"
 #include "core/object/ref_counted.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
 #include "core/variant/variant.h"
 #include "scene/main/node.h"
 #endif // LIMBOAI_MODULE
@@ -25,17 +28,261 @@
 #include <godot_cpp/classes/node.hpp>
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/classes/ref_counted.hpp>
+#include <godot_cpp/classes/stream_peer.hpp>
 #include <godot_cpp/core/object.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
+class Blackboard;
+
+// Pre-resolved reference to a blackboard variable (see Blackboard::resolve_var()).
+// Handles are owned by the caller, and are re-resolved automatically when the layout
+// of the blackboard changes (i.e., variables are added or removed, or parent is changed).
+struct BBHandle {
+	StringName name;
+	const Blackboard *origin = nullptr; // Blackboard used for resolution; only compared, never accessed.
+	Ref<Blackboard> target; // Scope that holds the variable.
+	uint32_t slot = 0;
+	uint64_t layout = 0; // Layout stamp of the origin's scope chain at resolution (see Blackboard::_get_chain_layout()).
+	bool published = false; // Target is a shared scope, read through its published snapshot instead of by slot.
+
+	_FORCE_INLINE_ bool is_resolved() const { return target.is_valid(); }
+
+	BBHandle() {}
+	BBHandle(const StringName &p_name) :
+			name(p_name) {}
+};
+
+// * Typed storage for scalar variables
+
+enum BBScalarKind : uint8_t {
+	BB_SCALAR_NONE,
+	BB_SCALAR_BOOL,
+	BB_SCALAR_INT,
+	BB_SCALAR_FLOAT,
+	BB_SCALAR_VECTOR2,
+	BB_SCALAR_VECTOR3,
+};
+
+// Describes how the value of a blackboard slot is stored.
+struct BBSlotInfo {
+	BBScalarKind kind = BB_SCALAR_NONE; // If not NONE, the value is stored unboxed in the scalar block.
+	bool shared = false; // If true, the variable is shared with a BlackboardPlan snapshot until modified.
+	uint32_t index = 0; // Index in the scalar block.
+	uint32_t version = 0; // Incremented when a value is assigned to the variable.
+};
+
+// Scalar values laid out in separate arrays per type.
+struct BBScalarBlock {
+	LocalVector<bool> bools;
+	LocalVector<int64_t> ints;
+	LocalVector<double> floats;
+	LocalVector<Vector2> vector2s;
+	LocalVector<Vector3> vector3s;
+
+	void clear() {
+		bools.clear();
+		ints.clear();
+		floats.clear();
+		vector2s.clear();
+		vector3s.clear();
+	}
+};
+
+template <typename T>
+struct BBScalarTraits {};
+
+template <>
+struct BBScalarTraits<bool> {
+	static constexpr BBScalarKind KIND = BB_SCALAR_BOOL;
+	_FORCE_INLINE_ static LocalVector<bool> &get_array(BBScalarBlock &p_block) { return p_block.bools; }
+	_FORCE_INLINE_ static const LocalVector<bool> &get_array(const BBScalarBlock &p_block) { return p_block.bools; }
+};
+
+template <>
+struct BBScalarTraits<int64_t> {
+	static constexpr BBScalarKind KIND = BB_SCALAR_INT;
+	_FORCE_INLINE_ static LocalVector<int64_t> &get_array(BBScalarBlock &p_block) { return p_block.ints; }
+	_FORCE_INLINE_ static const LocalVector<int64_t> &get_array(const BBScalarBlock &p_block) { return p_block.ints; }
+};
+
+template <>
+struct BBScalarTraits<double> {
+	static constexpr BBScalarKind KIND = BB_SCALAR_FLOAT;
+	_FORCE_INLINE_ static LocalVector<double> &get_array(BBScalarBlock &p_block) { return p_block.floats; }
+	_FORCE_INLINE_ static const LocalVector<double> &get_array(const BBScalarBlock &p_block) { return p_block.floats; }
+};
+
+template <>
+struct BBScalarTraits<Vector2> {
+	static constexpr BBScalarKind KIND = BB_SCALAR_VECTOR2;
+	_FORCE_INLINE_ static LocalVector<Vector2> &get_array(BBScalarBlock &p_block) { return p_block.vector2s; }
+	_FORCE_INLINE_ static const LocalVector<Vector2> &get_array(const BBScalarBlock &p_block) { return p_block.vector2s; }
+};
+
+template <>
+struct BBScalarTraits<Vector3> {
+	static constexpr BBScalarKind KIND = BB_SCALAR_VECTOR3;
+	_FORCE_INLINE_ static LocalVector<Vector3> &get_array(BBScalarBlock &p_block) { return p_block.vector3s; }
+	_FORCE_INLINE_ static const LocalVector<Vector3> &get_array(const BBScalarBlock &p_block) { return p_block.vector3s; }
+};
+
+// Collects variables read from blackboards on the current thread while installed (see Blackboard::push_read_recorder()).
+struct BBReadRecorder {
+	struct Read {
+		const Blackboard *blackboard = nullptr;
+		StringName name;
+	};
+	LocalVector<Read> reads;
+	BBReadRecorder *outer = nullptr; // Recorder that was installed before this one.
+};
+
 class Blackboard : public RefCounted {
 	GDCLASS(Blackboard, RefCounted);
 
+	friend class BlackboardPlan;
+	friend class SharedBlackboard;
+
 private:
-	HashMap<StringName, BBVariable> data;
+	// Variables are kept in a dense array of slots, and names are mapped to slot indices.
+	LocalVector<BBVariable> slots;
+	LocalVector<uint32_t> free_slots;
+	HashMap<StringName, uint32_t> slot_indices;
 	Ref<Blackboard> parent;
+	uint64_t version = 0;
+	uint64_t layout_version = 0; // Incremented when slot assignment changes.
+	bool has_nested_scopes = false; // Set once this blackboard becomes a parent of another one.
+	uint64_t binding_version = 0; // Incremented when variables are bound, unbound, linked or assigned.
+
+	// Variables populated from a BlackboardPlan don't own their data until they are modified:
+	// - Scalars store their values unboxed (see _assign_scalar()), keeping the plan's variable for metadata only.
+	// - Other variables share data with the plan's snapshot (see _assign_shared()).
+	// Such slots are converted to regular variables when they need to be modified in other ways than
+	// assigning a scalar value of the same type.
+	LocalVector<BBSlotInfo> slot_infos; // Parallel to slots.
+	BBScalarBlock scalars;
+
+	static BBScalarKind _get_scalar_kind(Variant::Type p_type);
+	bool _assign_scalar(const StringName &p_name, const BBVariable &p_plan_var);
+	void _assign_shared(const StringName &p_name, const BBVariable &p_snapshot_var);
+	Variant _get_scalar(uint32_t p_slot) const;
+	bool _set_scalar(uint32_t p_slot, const Variant &p_value);
+	Variant _get_unowned_value(uint32_t p_slot) const;
+	void _make_owned(uint32_t p_slot, bool p_copy_value = true);
+
+	static thread_local BBReadRecorder *read_recorder;
+	_FORCE_INLINE_ void _record_read(const StringName &p_name) const {
+		if (unlikely(read_recorder)) {
+			BBReadRecorder::Read read;
+			read.blackboard = this;
+			read.name = p_name;
+			read_recorder->reads.push_back(read);
+		}
+	}
+
+	_FORCE_INLINE_ bool _is_scalar(uint32_t p_slot) const { return slot_infos[p_slot].kind != BB_SCALAR_NONE; }
+	_FORCE_INLINE_ bool _is_owned(uint32_t p_slot) const {
+		const BBSlotInfo &info = slot_infos[p_slot];
+		return info.kind == BB_SCALAR_NONE && !info.shared;
+	}
+
+	// Bound and linked variables change without assignments to this blackboard, so their versions don't reflect all changes.
+	_FORCE_INLINE_ bool _is_version_tracked(uint32_t p_slot) const {
+		return !_is_owned(p_slot) || (!slots[p_slot].is_bound() && !slots[p_slot].is_shared());
+	}
+
+	_FORCE_INLINE_ Variant _get_slot_value(uint32_t p_slot) const {
+		return likely(_is_owned(p_slot)) ? slots[p_slot].get_value() : _get_unowned_value(p_slot);
+	}
+	_FORCE_INLINE_ void _set_slot_value(uint32_t p_slot, const Variant &p_value) {
+		if (unlikely(!_is_owned(p_slot))) {
+			if (_is_scalar(p_slot) && likely(_set_scalar(p_slot, p_value))) {
+				return;
+			}
+			_make_owned(p_slot, false);
+		}
+		slots[p_slot].set_value(p_value);
+	}
+
+	// Returns a variable that is safe to modify (slots that don't own their data are converted first).
+	_FORCE_INLINE_ BBVariable *_get_local(const StringName &p_name) {
+		HashMap<StringName, uint32_t>::Iterator E = slot_indices.find(p_name);
+		if (!E) {
+			return nullptr;
+		}
+		if (unlikely(!_is_owned(E->value))) {
+			_make_owned(E->value);
+		}
+		return &slots[E->value];
+	}
+	uint32_t _add_slot(const StringName &p_name, const BBVariable &p_var);
+	void _reserve_slots(uint32_t p_count);
+
+	// Watchers are invoked in a deferred call, once per changed variable, with the latest value.
+	HashMap<StringName, LocalVector<Callable>> watchers;
+	LocalVector<StringName> pending_changes;
+	bool flush_queued = false;
+
+	bool shared_scope = false; // True for SharedBlackboard.
+	bool notify_changes = false; // True if there are watchers, or this is a shared scope.
+
+	void _queue_change(const StringName &p_name);
+	static void _flush_deferred(const Ref<Blackboard> &p_blackboard);
+	void _notify_var_changed(const StringName &p_name);
+
+	template <typename T, typename TArray>
+	void _set_vars_from_packed(const TypedArray<StringName> &p_names, const TArray &p_values);
+	template <typename T, typename TArray>
+	TArray _get_vars_as_packed(const TypedArray<StringName> &p_names) const;
+
+	// Variable read from state data. Nodes and resources are resolved from their paths when applied.
+	struct StateVar {
+		StringName name;
+		uint8_t tag = 0;
+		Variant value;
+	};
+
+	void _save_scope(const Ref<StreamPeer> &p_stream) const;
+	static Error _read_scope(const Ref<StreamPeer> &p_stream, LocalVector<StateVar> &r_vars);
+	void _apply_scope(const LocalVector<StateVar> &p_vars);
+
+	_FORCE_INLINE_ void _var_changed(uint32_t p_slot, const StringName &p_name) {
+		slot_infos[p_slot].version += 1;
+		if (unlikely(notify_changes)) {
+			_notify_var_changed(p_name);
+		}
+	}
+
+	// Changes are also counted in parent scopes, as nested scopes may link their variables.
+	// Shared scopes are excluded: they are only modified on the main thread, while nested scopes may be updated on worker threads.
+	_FORCE_INLINE_ void _bump_version() {
+		for (Blackboard *bb = this; bb; bb = bb->parent.ptr()) {
+			if (unlikely(bb->shared_scope && bb != this)) {
+				break;
+			}
+			bb->version += 1;
+		}
+	}
+
+	// Incremented when the layout of any scope with nested scopes changes, or a shared scope publishes a new layout
+	// (nested scopes see the layout of a shared scope as of its last published snapshot).
+	static SafeNumeric<uint64_t> scope_layout_epoch;
+
+	void _layout_changed();
+	uint32_t _set_local_var(const StringName &p_name, const Variant &p_value);
+	void _set_var_by_handle_slow(BBHandle &r_handle, const Variant &p_value);
+
+	Variant _get_published_value(const BBHandle &p_handle, const Variant &p_default, bool p_complain) const;
+	uint32_t _get_published_version(const BBHandle &p_handle) const;
+
+	// Returns a stamp that changes whenever the layout of this blackboard or any of its parent scopes changes.
+	// Both counters only grow, so their sum is unique per layout of the chain, and no scopes need to be visited.
+	_FORCE_INLINE_ uint64_t _get_chain_layout() const {
+		return layout_version + scope_layout_epoch.get();
+	}
 
 protected:
 	static void _bind_methods();
@@ -45,7 +292,7 @@ protected:
 #endif
 
 public:
-	void set_parent(const Ref<Blackboard> &p_blackboard) { parent = p_blackboard; }
+	void set_parent(const Ref<Blackboard> &p_blackboard);
 	Ref<Blackboard> get_parent() const { return parent; }
 
 	Ref<Blackboard> top() const;
@@ -53,20 +300,200 @@ public:
 	Variant get_var(const StringName &p_name, const Variant &p_default = Variant(), bool p_complain = true) const;
 	void set_var(const StringName &p_name, const Variant &p_value);
 	bool has_var(const StringName &p_name) const;
-	_FORCE_INLINE_ bool has_local_var(const StringName &p_name) const { return data.has(p_name); }
+	_FORCE_INLINE_ bool has_local_var(const StringName &p_name) const { return slot_indices.has(p_name); }
 	void erase_var(const StringName &p_name);
-	void clear() { data.clear(); }
+	void clear();
 	TypedArray<StringName> list_vars() const;
 
 	Dictionary get_vars_as_dict() const;
 	void populate_from_dict(const Dictionary &p_dictionary);
 
+	// * Bulk access (version is bumped once per call)
+
+	Array get_vars(const TypedArray<StringName> &p_names, const Variant &p_default = Variant()) const;
+	void set_vars(const TypedArray<StringName> &p_names, const Array &p_values);
+
+	PackedFloat64Array get_vars_as_floats(const TypedArray<StringName> &p_names) const;
+	void set_vars_from_floats(const TypedArray<StringName> &p_names, const PackedFloat64Array &p_values);
+	PackedInt64Array get_vars_as_ints(const TypedArray<StringName> &p_names) const;
+	void set_vars_from_ints(const TypedArray<StringName> &p_names, const PackedInt64Array &p_values);
+
 	void bind_var_to_property(const StringName &p_name, Object *p_object, const StringName &p_property, bool p_create = false);
 	void unbind_var(const StringName &p_name);
 
 	void assign_var(const StringName &p_name, const BBVariable &p_var);
 
 	void link_var(const StringName &p_name, const Ref<Blackboard> &p_target_blackboard, const StringName &p_target_var, bool p_create = false);
+
+	bool is_isolated() const;
+	// Changes whenever the result of is_isolated() may change.
+	uint64_t get_isolation_version() const;
+
+	_FORCE_INLINE_ uint64_t get_version() const { return version; }
+	uint64_t get_scope_version() const;
+
+	// * Change notifications
+
+	uint32_t get_var_version(const StringName &p_name) const;
+
+	void watch_var(const StringName &p_name, const Callable &p_callable);
+	void unwatch_var(const StringName &p_name, const Callable &p_callable);
+	void flush_watchers();
+
+	// * State serialization
+
+	void save_state(const Ref<StreamPeer> &p_stream, bool p_include_parent_scopes = false) const;
+	Error load_state(const Ref<StreamPeer> &p_stream);
+
+	// * Handle-based access
+
+	BBHandle resolve_var(const StringName &p_name) const;
+
+	_FORCE_INLINE_ bool is_handle_valid(const BBHandle &p_handle) const {
+		return p_handle.origin == this && p_handle.layout == _get_chain_layout() && p_handle.target.is_valid();
+	}
+
+	// Same as get_var(), but skips name lookup while the handle remains valid.
+	_FORCE_INLINE_ Variant get_var_by_handle(BBHandle &r_handle, const Variant &p_default = Variant(), bool p_complain = true) const {
+		_record_read(r_handle.name);
+		if (unlikely(!is_handle_valid(r_handle))) {
+			r_handle = resolve_var(r_handle.name);
+			if (!r_handle.is_resolved()) {
+				return get_var(r_handle.name, p_default, p_complain);
+			}
+		}
+		if (unlikely(r_handle.published)) {
+			return _get_published_value(r_handle, p_default, p_complain);
+		}
+		return r_handle.target->_get_slot_value(r_handle.slot);
+	}
+
+	// Same as set_var(), but skips name lookup while the handle remains valid.
+	_FORCE_INLINE_ void set_var_by_handle(BBHandle &r_handle, const Variant &p_value) {
+		if (unlikely(!is_handle_valid(r_handle) || r_handle.target.ptr() != this)) {
+			_set_var_by_handle_slow(r_handle, p_value);
+			return;
+		}
+		_set_slot_value(r_handle.slot, p_value);
+		_var_changed(r_handle.slot, r_handle.name);
+		_bump_version();
+	}
+
+	// Same as get_var_version(), but skips name lookup while the handle remains valid.
+	_FORCE_INLINE_ uint32_t get_var_version_by_handle(BBHandle &r_handle) const {
+		if (unlikely(!is_handle_valid(r_handle))) {
+			r_handle = resolve_var(r_handle.name);
+			if (!r_handle.is_resolved()) {
+				return 0;
+			}
+		}
+		if (unlikely(r_handle.published)) {
+			return _get_published_version(r_handle);
+		}
+		return r_handle.target->slot_infos[r_handle.slot].version;
+	}
+
+	// Returns false if changes of the variable are not reflected in its version, i.e., it's bound to a property,
+	// or linked with another blackboard. Returns true for variables that don't exist.
+	bool is_var_version_tracked_by_handle(BBHandle &r_handle) const;
+
+	// * Read tracking
+
+	// Installs a recorder of variable reads on the current thread, until pop_read_recorder() is called.
+	static void push_read_recorder(BBReadRecorder *p_recorder);
+	static void pop_read_recorder();
+
+	// Same as get_var_by_handle() for multiple variables.
+	_FORCE_INLINE_ void get_vars_by_handles(BBHandle *r_handles, Variant *r_values, uint32_t p_count, const Variant &p_default = Variant()) const {
+		for (uint32_t i = 0; i < p_count; i++) {
+			r_values[i] = get_var_by_handle(r_handles[i], p_default);
+		}
+	}
+
+	// Same as set_var_by_handle() for multiple variables, but bumps version only once.
+	void set_vars_by_handles(BBHandle *r_handles, const Variant *p_values, uint32_t p_count);
+
+	// * Typed access to scalar variables (bool, int64_t, double, Vector2, Vector3)
+
+	// Reads the value without constructing a Variant.
+	// Returns false if the variable is not stored as a scalar of type T; use get_var_by_handle() in that case.
+	template <typename T>
+	_FORCE_INLINE_ bool get_scalar_by_handle(BBHandle &r_handle, T &r_value) const {
+		_record_read(r_handle.name);
+		if (unlikely(!is_handle_valid(r_handle))) {
+			r_handle = resolve_var(r_handle.name);
+			if (!r_handle.is_resolved()) {
+				return false;
+			}
+		}
+		if (unlikely(r_handle.published)) {
+			return false; // Snapshots store boxed values.
+		}
+		const Blackboard *target = r_handle.target.ptr();
+		const BBSlotInfo &ref = target->slot_infos[r_handle.slot];
+		if (ref.kind != BBScalarTraits<T>::KIND) {
+			return false;
+		}
+		r_value = BBScalarTraits<T>::get_array(target->scalars)[ref.index];
+		return true;
+	}
+
+	// Assigns the value without constructing a Variant.
+	// Returns false if the variable is not a local scalar of type T; use set_var_by_handle() in that case.
+	template <typename T>
+	_FORCE_INLINE_ bool set_scalar_by_handle(BBHandle &r_handle, const T &p_value) {
+		if (unlikely(!is_handle_valid(r_handle))) {
+			r_handle = resolve_var(r_handle.name);
+		}
+		if (r_handle.target.ptr() != this) {
+			return false;
+		}
+		const BBSlotInfo &ref = slot_infos[r_handle.slot];
+		if (ref.kind != BBScalarTraits<T>::KIND) {
+			return false;
+		}
+		BBScalarTraits<T>::get_array(scalars)[ref.index] = p_value;
+		_var_changed(r_handle.slot, r_handle.name);
+		_bump_version();
+		return true;
+	}
+
+	// Same as get_scalar_by_handle() for multiple variables, but converts values of other types.
+	// Missing variables are read as T().
+	template <typename T>
+	void get_scalars_by_handles(BBHandle *r_handles, T *r_values, uint32_t p_count, bool p_complain = true) const {
+		for (uint32_t i = 0; i < p_count; i++) {
+			if (unlikely(!get_scalar_by_handle(r_handles[i], r_values[i]))) {
+				r_values[i] = get_var_by_handle(r_handles[i], T(), p_complain);
+			}
+		}
+	}
+
+	// Same as set_scalar_by_handle() for multiple variables, but bumps version only once.
+	// Variables that are not local scalars of type T are assigned via set_var_by_handle().
+	template <typename T>
+	void set_scalars_by_handles(BBHandle *r_handles, const T *p_values, uint32_t p_count) {
+		bool changed = false;
+		for (uint32_t i = 0; i < p_count; i++) {
+			BBHandle &handle = r_handles[i];
+			if (unlikely(!is_handle_valid(handle))) {
+				handle = resolve_var(handle.name);
+			}
+			if (likely(handle.target.ptr() == this)) {
+				const BBSlotInfo &ref = slot_infos[handle.slot];
+				if (likely(ref.kind == BBScalarTraits<T>::KIND)) {
+					BBScalarTraits<T>::get_array(scalars)[ref.index] = p_values[i];
+					_var_changed(handle.slot, handle.name);
+					changed = true;
+					continue;
+				}
+			}
+			set_var_by_handle(handle, p_values[i]);
+		}
+		if (changed) {
+			_bump_version();
+		}
+	}
 };
 
 #endif // BLACKBOARD_H
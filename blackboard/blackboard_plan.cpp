@@ -11,18 +11,33 @@
 
 #include "blackboard_plan.h"
 
+#include "../util/limbo_compat.h"
+#include "../util/limbo_string_names.h"
 #include "../util/limbo_utility.h"
+#include "shared_blackboard.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
+#include "core/os/time.h"
 #include "editor/editor_inspector.h"
 #include "editor/editor_interface.h"
+#include "main/performance.h"
 #elif LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/editor_inspector.hpp>
 #include <godot_cpp/classes/editor_interface.hpp>
 #include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/performance.hpp>
 #include <godot_cpp/classes/scene_tree.hpp>
+#include <godot_cpp/classes/time.hpp>
 #endif
 
+LocalVector<BlackboardPlan::PrefetchRequest> BlackboardPlan::pending_prefetch;
+bool BlackboardPlan::prefetch_queued = false;
+uint64_t BlackboardPlan::population_frame = 0;
+uint64_t BlackboardPlan::population_frame_usec = 0;
+uint64_t BlackboardPlan::population_peak_usec = 0;
+bool BlackboardPlan::population_monitors_added = false;
+
 bool BlackboardPlan::_set(const StringName &p_name, const Variant &p_value) {
 	String name_str = p_name;
 
@@ -300,6 +315,11 @@ void BlackboardPlan::set_property_binding(const StringName &p_name, const NodePa
 	emit_changed();
 }
 
+void BlackboardPlan::set_shared_scope(const StringName &p_scope) {
+	shared_scope = p_scope;
+	emit_changed();
+}
+
 void BlackboardPlan::set_prefetch_nodepath_vars(bool p_enable) {
 	prefetch_nodepath_vars = p_enable;
 	emit_changed();
@@ -313,6 +333,112 @@ bool BlackboardPlan::is_prefetching_nodepath_vars() const {
 	}
 }
 
+void BlackboardPlan::set_prefetch_deferred(bool p_enable) {
+	prefetch_deferred = p_enable;
+	emit_changed();
+}
+
+bool BlackboardPlan::is_prefetch_deferred() const {
+	if (is_derived()) {
+		return base->is_prefetch_deferred();
+	} else {
+		return prefetch_deferred;
+	}
+}
+
+void BlackboardPlan::flush_prefetch() {
+	prefetch_queued = false;
+	if (pending_prefetch.is_empty()) {
+		return;
+	}
+	const uint64_t start = Time::get_singleton()->get_ticks_usec();
+
+	LocalVector<PrefetchRequest> requests;
+	SWAP(requests, pending_prefetch);
+
+	// Lookups are shared by agents with the same root. Absolute paths resolve to the same node for every root.
+	HashMap<Pair<uint64_t, NodePath>, Node *, PrefetchKeyHasher> resolved;
+	for (const PrefetchRequest &req : requests) {
+		if (req.blackboard->get_reference_count() == 1) {
+			// Blackboard is no longer in use.
+			continue;
+		}
+		Node *root = Object::cast_to<Node>(OBJECT_DB_GET_INSTANCE(req.root_id));
+		if (root == nullptr) {
+			continue;
+		}
+		// Leading ".." are walked up first, so that agents with a common ancestor share the rest of the lookup.
+		Node *base = root;
+		NodePath path = req.path;
+		int num_up = 0;
+		while (!path.is_absolute() && num_up < path.get_name_count() && path.get_name(num_up) == LW_NAME(dot_dot)) {
+			num_up += 1;
+		}
+		if (num_up > 0) {
+			for (int i = 0; i < num_up && base; i++) {
+				base = base->get_parent();
+			}
+			PackedStringArray rest;
+			for (int i = num_up; i < path.get_name_count(); i++) {
+				rest.push_back(path.get_name(i));
+			}
+			path = rest.is_empty() ? NodePath(".") : NodePath(String("/").join(rest));
+		}
+		Node *n = nullptr;
+		if (base) {
+			const Pair<uint64_t, NodePath> key(path.is_absolute() ? 0 : uint64_t(base->get_instance_id()), path);
+			HashMap<Pair<uint64_t, NodePath>, Node *, PrefetchKeyHasher>::Iterator E = resolved.find(key);
+			if (E) {
+				n = E->value;
+			} else {
+				n = base->get_node_or_null(path);
+				resolved.insert(key, n);
+			}
+		}
+		if (n == nullptr) {
+			ERR_PRINT(vformat("BlackboardPlan: Prefetch failed for variable $%s with value: %s", req.var, req.path));
+			continue;
+		}
+		// Values assigned in the meantime are not overwritten.
+		if (req.blackboard->has_local_var(req.var) && req.blackboard->get_var(req.var, Variant(), false).get_type() == Variant::NIL) {
+			req.blackboard->set_var(req.var, n);
+		}
+	}
+
+	_record_population_time(Time::get_singleton()->get_ticks_usec() - start);
+}
+
+void BlackboardPlan::clear_pending_prefetch() {
+	pending_prefetch.clear();
+}
+
+void BlackboardPlan::_record_population_time(uint64_t p_usec) {
+	const uint64_t frame = Engine::get_singleton()->get_process_frames();
+	if (frame != population_frame) {
+		population_frame = frame;
+		population_frame_usec = 0;
+	}
+	population_frame_usec += p_usec;
+	population_peak_usec = MAX(population_peak_usec, population_frame_usec);
+
+	if (unlikely(!population_monitors_added) && Performance::get_singleton()) {
+		population_monitors_added = true;
+		PERFORMANCE_ADD_CUSTOM_MONITOR("LimboAI/blackboard_population_peak_ms", callable_mp_static(&BlackboardPlan::_get_population_peak_ms));
+		PERFORMANCE_ADD_CUSTOM_MONITOR("LimboAI/blackboard_pending_prefetch", callable_mp_static(&BlackboardPlan::_get_pending_prefetch_count));
+	}
+}
+
+double BlackboardPlan::_get_population_peak_ms() {
+	// Highest time per frame since the last read.
+	const double peak_ms = population_peak_usec * 0.001;
+	population_peak_usec = 0;
+	return peak_ms;
+}
+
+double BlackboardPlan::_get_pending_prefetch_count() {
+	return pending_prefetch.size();
+}
+
 void BlackboardPlan::add_var(const StringName &p_name, const BBVariable &p_var) {
 	ERR_FAIL_COND(p_name == StringName());
 	ERR_FAIL_COND(var_map.has(p_name));
@@ -496,10 +622,39 @@ Ref<Blackboard> BlackboardPlan::create_blackboard(Node *p_prefetch_root, const R
 	return bb;
 }
 
+const BBVariable &BlackboardPlan::_get_snapshot_var(uint32_t p_index, const BBVariable &p_var) {
+	if (snapshot.size() <= p_index) {
+		snapshot.resize(p_index + 1);
+	}
+	SnapshotEntry &entry = snapshot[p_index];
+	if (!entry.source.is_same_data(p_var) || entry.source_revision != p_var.get_revision()) {
+		entry.source = p_var;
+		entry.source_revision = p_var.get_revision();
+		entry.var = p_var.duplicate(true);
+	}
+	return entry.var;
+}
+
 void BlackboardPlan::populate_blackboard(const Ref<Blackboard> &p_blackboard, bool overwrite, Node *p_prefetch_root, Node *p_prefetch_root_for_base_plan) {
 	ERR_FAIL_COND(p_prefetch_root == nullptr && prefetch_nodepath_vars);
 	ERR_FAIL_COND(p_blackboard.is_null());
+	const uint64_t start = Time::get_singleton()->get_ticks_usec();
+	const bool deferred = is_prefetch_deferred();
+
+	// Derived plans inherit the shared scope from the base plan.
+	const StringName scope_name = shared_scope == StringName() && is_derived() ? base->shared_scope : shared_scope;
+	if (scope_name != StringName() && p_blackboard->get_parent().is_null()) {
+		Ref<SharedBlackboard> scope = SharedBlackboard::get_scope(scope_name);
+		if (scope.ptr() != p_blackboard.ptr()) {
+			p_blackboard->set_parent(scope);
+		}
+	}
+
+	// Variables are added in plan order, so on a fresh blackboard they occupy consecutive slots.
+	p_blackboard->_reserve_slots(var_list.size());
+	uint32_t var_index = 0;
 	for (const Pair<StringName, BBVariable> &p : var_list) {
+		const uint32_t snapshot_index = var_index++;
 		if (p_blackboard->has_local_var(p.first) && !overwrite) {
 #ifdef DEBUG_ENABLED
 			Variant::Type existing_type = p_blackboard->get_var(p.first).get_type();
@@ -515,12 +670,36 @@ void BlackboardPlan::populate_blackboard(const Ref<Blackboard> &p_blackboard, bo
 		bool has_mapping = parent_scope_mapping.has(p.first);
 		bool do_prefetch = !is_bound && !has_mapping && prefetch_nodepath_vars;
 
+		if (!is_bound && !has_mapping) {
+			// Scalars are stored unboxed, sharing metadata with the plan.
+			if (p_blackboard->_assign_scalar(p.first, p.second)) {
+				continue;
+			}
+			// Copy-on-write: other variables share the plan's snapshot until modified.
+			if (!(do_prefetch && p.second.get_type() == Variant::NODE_PATH)) {
+				p_blackboard->_assign_shared(p.first, _get_snapshot_var(snapshot_index, p.second));
+				continue;
+			}
+		}
+
 		// Add a variable duplicate to the blackboard, optionally with NodePath prefetch.
 		BBVariable var = p.second.duplicate(true);
 		if (unlikely(do_prefetch && p.second.get_type() == Variant::NODE_PATH)) {
 			Node *prefetch_root = !p_prefetch_root_for_base_plan || !is_derived() || is_derived_var_changed(p.first) ? p_prefetch_root : p_prefetch_root_for_base_plan;
-			Node *n = prefetch_root->get_node_or_null(p.second.get_value());
-			if (n != nullptr) {
+			if (deferred) {
+				// Resolved in flush_prefetch().
+				PrefetchRequest req;
+				req.blackboard = p_blackboard;
+				req.var = p.first;
+				req.path = p.second.get_value();
+				req.root_id = prefetch_root->get_instance_id();
+				pending_prefetch.push_back(req);
+				if (!prefetch_queued) {
+					prefetch_queued = true;
+					callable_mp_static(&BlackboardPlan::flush_prefetch).call_deferred();
+				}
+				var.set_value(Variant());
+			} else if (Node *n = prefetch_root->get_node_or_null(p.second.get_value())) {
 				var.set_value(n);
 			} else {
 				ERR_PRINT(vformat("BlackboardPlan: Prefetch failed for variable $%s with value: %s", p.first, p.second.get_value()));
@@ -555,11 +734,16 @@ void BlackboardPlan::populate_blackboard(const Ref<Blackboard> &p_blackboard, bo
 			var.bind(n, prop_name);
 		}
 	}
+
+	_record_population_time(Time::get_singleton()->get_ticks_usec() - start);
 }
 
 void BlackboardPlan::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_prefetch_nodepath_vars", "enable"), &BlackboardPlan::set_prefetch_nodepath_vars);
 	ClassDB::bind_method(D_METHOD("is_prefetching_nodepath_vars"), &BlackboardPlan::is_prefetching_nodepath_vars);
+	ClassDB::bind_method(D_METHOD("set_prefetch_deferred", "enable"), &BlackboardPlan::set_prefetch_deferred);
+	ClassDB::bind_method(D_METHOD("is_prefetch_deferred"), &BlackboardPlan::is_prefetch_deferred);
+	ClassDB::bind_static_method("BlackboardPlan", D_METHOD("flush_prefetch"), &BlackboardPlan::flush_prefetch);
 
 	ClassDB::bind_method(D_METHOD("set_base_plan", "blackboard_plan"), &BlackboardPlan::set_base_plan);
 	ClassDB::bind_method(D_METHOD("get_base_plan"), &BlackboardPlan::get_base_plan);
@@ -570,8 +754,13 @@ void BlackboardPlan::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("create_blackboard", "prefetch_root", "parent_scope", "prefetch_root_for_base_plan"), &BlackboardPlan::create_blackboard, DEFVAL(Ref<Blackboard>()), DEFVAL(Variant()));
 	ClassDB::bind_method(D_METHOD("populate_blackboard", "blackboard", "overwrite", "prefetch_root", "prefetch_root_for_base_plan"), &BlackboardPlan::populate_blackboard, DEFVAL(Variant()));
 
+	ClassDB::bind_method(D_METHOD("set_shared_scope", "scope"), &BlackboardPlan::set_shared_scope);
+	ClassDB::bind_method(D_METHOD("get_shared_scope"), &BlackboardPlan::get_shared_scope);
+
 	// To avoid cluttering the member namespace, we do not export unnecessary properties in this class.
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "prefetch_nodepath_vars", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_prefetch_nodepath_vars", "is_prefetching_nodepath_vars");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "prefetch_deferred", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_prefetch_deferred", "is_prefetch_deferred");
+	ADD_PROPERTY(PropertyInfo(Variant::STRING_NAME, "shared_scope", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_STORAGE), "set_shared_scope", "get_shared_scope");
 }
 
 BlackboardPlan::BlackboardPlan() {
@@ -48,8 +48,52 @@ private:
 	HashMap<StringName, NodePath> property_bindings;
 	bool property_binding_enabled = false;
 
+	// Name of the SharedBlackboard scope that is attached as the parent of top-level blackboards (optional).
+	StringName shared_scope;
+
 	// If true, NodePath variables will be prefetched, so that the vars will contain node pointers instead (upon BB creation/population).
 	bool prefetch_nodepath_vars = true;
+	// If true, prefetching is postponed until the end of the frame, and done in a batch for all populated blackboards.
+	bool prefetch_deferred = false;
+
+	struct PrefetchRequest {
+		Ref<Blackboard> blackboard;
+		StringName var;
+		NodePath path;
+		ObjectID root_id;
+	};
+	static LocalVector<PrefetchRequest> pending_prefetch;
+	static bool prefetch_queued;
+
+	// Prefetch lookups are cached per (root, path) during flush.
+	struct PrefetchKeyHasher {
+		static uint32_t hash(const Pair<uint64_t, NodePath> &P) {
+			uint64_t h1 = HashMapHasherDefault::hash(P.first);
+			uint64_t h2 = HashMapHasherDefault::hash(P.second);
+			return hash_one_uint64((h1 << 32) | h2);
+		}
+	};
+
+	// * Population time metric (main thread only).
+	static uint64_t population_frame;
+	static uint64_t population_frame_usec;
+	static uint64_t population_peak_usec;
+	static bool population_monitors_added;
+
+	static void _record_population_time(uint64_t p_usec);
+	static double _get_population_peak_ms();
+	static double _get_pending_prefetch_count();
+
+	// Duplicates of the variables, shared by blackboards populated from this plan until they are modified.
+	// Entries follow var_list order, and are refreshed when the corresponding plan variable changes.
+	struct SnapshotEntry {
+		BBVariable source;
+		uint32_t source_revision = 0;
+		BBVariable var;
+	};
+	LocalVector<SnapshotEntry> snapshot;
+
+	const BBVariable &_get_snapshot_var(uint32_t p_index, const BBVariable &p_var);
 
 	_FORCE_INLINE_ bool _is_var_hidden(const String &p_name, const BBVariable &p_var) const { return p_var.get_type() == Variant::NIL || (is_derived() && p_name.begins_with("_")); }
 
@@ -80,9 +124,19 @@ public:
 	void set_property_binding(const StringName &p_name, const NodePath &p_path);
 	NodePath get_property_binding(const StringName &p_name) const { return property_bindings.has(p_name) ? property_bindings[p_name] : NodePath(); }
 
+	void set_shared_scope(const StringName &p_scope);
+	StringName get_shared_scope() const { return shared_scope; }
+
 	void set_prefetch_nodepath_vars(bool p_enable);
 	bool is_prefetching_nodepath_vars() const;
 
+	void set_prefetch_deferred(bool p_enable);
+	bool is_prefetch_deferred() const;
+
+	// Resolves NodePath variables of all blackboards populated with deferred prefetching.
+	static void flush_prefetch();
+	static void clear_pending_prefetch();
+
 	void add_var(const StringName &p_name, const BBVariable &p_var);
 	void remove_var(const StringName &p_name);
 	BBVariable get_var(const StringName &p_name);
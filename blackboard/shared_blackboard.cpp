@@ -0,0 +1,174 @@
+/**
+ * shared_blackboard.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "shared_blackboard.h"
+
+HashMap<StringName, Ref<SharedBlackboard>> SharedBlackboard::scopes;
+LocalVector<SharedBlackboard *> SharedBlackboard::pending_publish;
+bool SharedBlackboard::publish_queued = false;
+
+Ref<SharedBlackboard> SharedBlackboard::get_scope(const StringName &p_name) {
+	ERR_FAIL_COND_V_MSG(p_name == StringName(), Ref<SharedBlackboard>(), "SharedBlackboard: Scope name is empty.");
+	HashMap<StringName, Ref<SharedBlackboard>>::Iterator E = scopes.find(p_name);
+	if (E) {
+		return E->value;
+	}
+	Ref<SharedBlackboard> scope = memnew(SharedBlackboard);
+	scopes.insert(p_name, scope);
+	return scope;
+}
+
+bool SharedBlackboard::has_scope(const StringName &p_name) {
+	return scopes.has(p_name);
+}
+
+void SharedBlackboard::remove_scope(const StringName &p_name) {
+	scopes.erase(p_name);
+}
+
+void SharedBlackboard::clear_scopes() {
+	scopes.clear();
+}
+
+void SharedBlackboard::_queue_publish() {
+	if (pending) {
+		return;
+	}
+	pending = true;
+	pending_publish.push_back(this);
+	if (!publish_queued) {
+		publish_queued = true;
+		callable_mp_static(&SharedBlackboard::publish_pending).call_deferred();
+	}
+}
+
+void SharedBlackboard::publish_pending() {
+	publish_queued = false;
+	LocalVector<SharedBlackboard *> to_publish = pending_publish;
+	pending_publish.clear();
+	for (SharedBlackboard *scope : to_publish) {
+		scope->pending = false;
+		scope->publish();
+	}
+}
+
+// Readers get containers by reference, so nested containers are made read-only as well.
+static void _make_read_only(const Variant &p_value) {
+	if (p_value.get_type() == Variant::ARRAY) {
+		Array arr = p_value;
+		for (int i = 0; i < arr.size(); i++) {
+			_make_read_only(arr[i]);
+		}
+		arr.make_read_only();
+	} else if (p_value.get_type() == Variant::DICTIONARY) {
+		Dictionary dict = p_value;
+		const Array values = dict.values();
+		for (int i = 0; i < values.size(); i++) {
+			_make_read_only(values[i]);
+		}
+		dict.make_read_only();
+	}
+}
+
+void SharedBlackboard::publish() {
+	// Only the main thread publishes, so the current snapshot can be read without pinning.
+	const Snapshot *current = published.load(std::memory_order_relaxed);
+	// Slot versions are comparable only if slots weren't reassigned.
+	const bool can_reuse = current && current->layout_version == layout_version;
+
+	Snapshot *snapshot = memnew(Snapshot);
+	snapshot->vars.reserve(slot_indices.size());
+	snapshot->layout_version = layout_version;
+	for (const KeyValue<StringName, uint32_t> &kv : slot_indices) {
+		const uint32_t slot = kv.value;
+		if (can_reuse) {
+			// Bound and linked variables change without assignments to this scope, so they are always copied.
+			const SnapshotVar *prev = current->vars.getptr(kv.key);
+			if (_is_version_tracked(slot) && prev && prev->version == slot_infos[slot].version) {
+				snapshot->vars.insert(kv.key, *prev);
+				continue;
+			}
+		}
+		SnapshotVar var;
+		var.value = _get_slot_value(slot);
+		if (var.value.get_type() == Variant::ARRAY || var.value.get_type() == Variant::DICTIONARY) {
+			// Readers must not observe modifications made in place, nor make any.
+			var.value = var.value.duplicate(true);
+			_make_read_only(var.value);
+		}
+		var.version = slot_infos[slot].version;
+		var.version_tracked = _is_version_tracked(slot);
+		snapshot->vars.insert(kv.key, var);
+	}
+
+	const Snapshot *previous = published.exchange(snapshot, std::memory_order_seq_cst);
+	if (previous) {
+		retired.push_back(previous);
+	}
+	// Readers that pin after the exchange get the new snapshot.
+	if (readers.load(std::memory_order_seq_cst) == 0) {
+		_free_retired();
+	}
+	if (!can_reuse) {
+		// Handles of nested scopes may now resolve differently.
+		scope_layout_epoch.increment();
+	}
+
+	if (pending) {
+		pending = false;
+		pending_publish.erase(this);
+	}
+}
+
+void SharedBlackboard::_free_retired() {
+	for (const Snapshot *snapshot : retired) {
+		memdelete(const_cast<Snapshot *>(snapshot));
+	}
+	retired.clear();
+}
+
+bool SharedBlackboard::get_published_var(const StringName &p_name, SnapshotVar &r_var) const {
+	const ReadLock lock(this);
+	const SnapshotVar *var = lock.get_var(p_name);
+	if (var == nullptr) {
+		return false;
+	}
+	r_var = *var;
+	return true;
+}
+
+bool SharedBlackboard::has_published_var(const StringName &p_name) const {
+	const ReadLock lock(this);
+	return lock.get_var(p_name) != nullptr;
+}
+
+void SharedBlackboard::_bind_methods() {
+	ClassDB::bind_static_method("SharedBlackboard", D_METHOD("get_scope", "name"), &SharedBlackboard::get_scope);
+	ClassDB::bind_static_method("SharedBlackboard", D_METHOD("has_scope", "name"), &SharedBlackboard::has_scope);
+	ClassDB::bind_static_method("SharedBlackboard", D_METHOD("remove_scope", "name"), &SharedBlackboard::remove_scope);
+	ClassDB::bind_method(D_METHOD("publish"), &SharedBlackboard::publish);
+}
+
+SharedBlackboard::SharedBlackboard() {
+	shared_scope = true;
+	notify_changes = true;
+}
+
+SharedBlackboard::~SharedBlackboard() {
+	if (pending) {
+		pending_publish.erase(this);
+	}
+	const Snapshot *snapshot = published.load(std::memory_order_acquire);
+	if (snapshot) {
+		memdelete(const_cast<Snapshot *>(snapshot));
+	}
+	_free_retired();
+}
@@ -0,0 +1,101 @@
+/**
+ * shared_blackboard.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef SHARED_BLACKBOARD_H
+#define SHARED_BLACKBOARD_H
+
+#include "blackboard.h"
+
+#include <atomic>
+
+/**
+ * Blackboard scope shared by many agents (e.g., world or squad knowledge).
+ *
+ * The scope is modified on the main thread, while nested scopes read a published snapshot
+ * of its variables. Snapshots are immutable, so reading doesn't require locking and is safe
+ * from worker threads. Changes are published once per frame in a deferred call, or on demand.
+ * Readers pin the snapshot they use (see ReadLock), and replaced snapshots are freed on a later
+ * publish, once no reads are in flight.
+ */
+class SharedBlackboard : public Blackboard {
+	GDCLASS(SharedBlackboard, Blackboard);
+
+public:
+	struct SnapshotVar {
+		Variant value;
+		uint32_t version = 0;
+		bool version_tracked = true; // False for bound and linked variables (see Blackboard::is_var_version_tracked_by_handle()).
+	};
+
+	struct Snapshot {
+		HashMap<StringName, SnapshotVar> vars;
+		uint64_t layout_version = 0; // Layout of the scope when published; a new layout invalidates handles of nested scopes.
+	};
+
+private:
+	static HashMap<StringName, Ref<SharedBlackboard>> scopes;
+	static LocalVector<SharedBlackboard *> pending_publish;
+	static bool publish_queued;
+
+	std::atomic<const Snapshot *> published{ nullptr };
+	mutable std::atomic<uint32_t> readers{ 0 }; // Number of ReadLocks in flight.
+	// Replaced snapshots, kept until no reads are in flight.
+	LocalVector<const Snapshot *> retired;
+	bool pending = false;
+
+	friend class Blackboard;
+	void _queue_publish();
+	void _free_retired();
+
+protected:
+	static void _bind_methods();
+
+public:
+	static Ref<SharedBlackboard> get_scope(const StringName &p_name);
+	static bool has_scope(const StringName &p_name);
+	static void remove_scope(const StringName &p_name);
+	static void clear_scopes();
+
+	// Publishes all scopes that have unpublished changes.
+	static void publish_pending();
+
+	void publish();
+
+	// Pins the published snapshot, so that it isn't freed while in use. Pointers obtained
+	// from the lock are valid until it's destroyed.
+	class ReadLock {
+		const SharedBlackboard *scope;
+		const Snapshot *snapshot;
+
+	public:
+		_FORCE_INLINE_ const Snapshot *get_snapshot() const { return snapshot; }
+		_FORCE_INLINE_ const SnapshotVar *get_var(const StringName &p_name) const {
+			return snapshot ? snapshot->vars.getptr(p_name) : nullptr;
+		}
+
+		_FORCE_INLINE_ ReadLock(const SharedBlackboard *p_scope) :
+				scope(p_scope) {
+			// Sequentially consistent, so that publish() either sees this reader, or this reader sees the new snapshot.
+			scope->readers.fetch_add(1, std::memory_order_seq_cst);
+			snapshot = scope->published.load(std::memory_order_seq_cst);
+		}
+		_FORCE_INLINE_ ~ReadLock() { scope->readers.fetch_sub(1, std::memory_order_release); }
+	};
+
+	// Copies the published variable into r_var. Returns false if it isn't published.
+	bool get_published_var(const StringName &p_name, SnapshotVar &r_var) const;
+	bool has_published_var(const StringName &p_name) const;
+
+	SharedBlackboard();
+	~SharedBlackboard();
+};
+
+#endif // SHARED_BLACKBOARD_H
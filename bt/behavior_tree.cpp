@@ -62,6 +62,11 @@ void BehaviorTree::set_root_task(const Ref<BTTask> &p_value) {
 	emit_changed();
 }
 
+void BehaviorTree::set_share_task_config(bool p_enable) {
+	share_task_config = p_enable;
+	emit_changed();
+}
+
 Ref<BehaviorTree> BehaviorTree::clone() const {
 	Ref<BehaviorTree> copy = duplicate(false);
 	copy->set_path("");
@@ -75,6 +80,7 @@ void BehaviorTree::copy_other(const Ref<BehaviorTree> &p_other) {
 	ERR_FAIL_COND(p_other.is_null());
 	description = p_other->get_description();
 	root_task = p_other->get_root_task();
+	share_task_config = p_other->get_share_task_config();
 }
 
 Ref<BTInstance> BehaviorTree::instantiate(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, Node *p_custom_scene_root) const {
@@ -84,7 +90,7 @@ Ref<BTInstance> BehaviorTree::instantiate(Node *p_agent, const Ref<Blackboard> &
 	ERR_FAIL_NULL_V_MSG(p_blackboard, nullptr, "BehaviorTree: Instantiation failed - blackboard can't be null.");
 	Node *scene_root = p_custom_scene_root ? p_custom_scene_root : p_instance_owner->get_owner();
 	ERR_FAIL_NULL_V_MSG(scene_root, nullptr, "BehaviorTree: Instantiation failed - unable to establish scene root. This is likely due to the instance owner not being owned by a scene node and custom_scene_root being null.");
-	Ref<BTTask> root_copy = root_task->clone();
+	Ref<BTTask> root_copy = share_task_config ? root_task->clone_shared() : root_task->clone();
 	root_copy->initialize(p_agent, p_blackboard, scene_root);
 	return BTInstance::create(root_copy, get_path(), p_instance_owner);
 }
@@ -117,12 +123,15 @@ void BehaviorTree::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_blackboard_plan"), &BehaviorTree::get_blackboard_plan);
 	ClassDB::bind_method(D_METHOD("set_root_task", "task"), &BehaviorTree::set_root_task);
 	ClassDB::bind_method(D_METHOD("get_root_task"), &BehaviorTree::get_root_task);
+	ClassDB::bind_method(D_METHOD("set_share_task_config", "enable"), &BehaviorTree::set_share_task_config);
+	ClassDB::bind_method(D_METHOD("get_share_task_config"), &BehaviorTree::get_share_task_config);
 	ClassDB::bind_method(D_METHOD("clone"), &BehaviorTree::clone);
 	ClassDB::bind_method(D_METHOD("copy_other", "other"), &BehaviorTree::copy_other);
 	ClassDB::bind_method(D_METHOD("instantiate", "agent", "blackboard", "instance_owner", "custom_scene_root"), &BehaviorTree::instantiate, DEFVAL(Variant()));
 
 	ADD_PROPERTY(PropertyInfo(Variant::STRING, "description", PROPERTY_HINT_MULTILINE_TEXT), "set_description", "get_description");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard_plan", PROPERTY_HINT_RESOURCE_TYPE, "BlackboardPlan", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT), "set_blackboard_plan", "get_blackboard_plan");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "share_task_config"), "set_share_task_config", "get_share_task_config");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "root_task", PROPERTY_HINT_RESOURCE_TYPE, "BTTask", PROPERTY_USAGE_NO_EDITOR | PROPERTY_USAGE_INTERNAL), "set_root_task", "get_root_task");
 
 	ADD_SIGNAL(MethodInfo("plan_changed"));
@@ -32,6 +32,7 @@ private:
 	String description;
 	Ref<BlackboardPlan> blackboard_plan;
 	Ref<BTTask> root_task;
+	bool share_task_config = false;
 
 	void _plan_changed();
 
@@ -61,6 +62,9 @@ public:
 	void set_root_task(const Ref<BTTask> &p_value);
 	Ref<BTTask> get_root_task() const { return root_task; }
 
+	void set_share_task_config(bool p_enable);
+	bool get_share_task_config() const { return share_task_config; }
+
 	Ref<BehaviorTree> clone() const;
 	void copy_other(const Ref<BehaviorTree> &p_other);
 	Ref<BTInstance> instantiate(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_instance_owner, Node *p_custom_scene_root = nullptr) const;
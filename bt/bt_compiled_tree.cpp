@@ -0,0 +1,217 @@
+/**
+ * bt_compiled_tree.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_compiled_tree.h"
+
+#include "../util/limbo_compat.h"
+#include "bt_profiler.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/script_language.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/script.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+BTCompiledTree::Opcode BTCompiledTree::_get_opcode(const BTTask *p_task) {
+	// Scripted tasks may override any of the virtual methods.
+	Ref<Script> sc = GET_SCRIPT(p_task);
+	if (sc.is_valid()) {
+		return OP_LEAF;
+	}
+
+	// Exact class match: native subclasses may change the behavior.
+	const String cls = p_task->get_class();
+	const int num_children = p_task->get_child_count();
+	if (cls == "BTSequence") {
+		return OP_SEQUENCE;
+	} else if (cls == "BTSelector") {
+		return OP_SELECTOR;
+	} else if (num_children != 1) {
+		// Decorators report errors when misconfigured - let them handle it.
+		return OP_LEAF;
+	} else if (cls == "BTInvert") {
+		return OP_INVERT;
+	} else if (cls == "BTAlwaysSucceed") {
+		return OP_ALWAYS_SUCCEED;
+	} else if (cls == "BTAlwaysFail") {
+		return OP_ALWAYS_FAIL;
+	} else if (cls == "BTNewScope" || cls == "BTSubtree") {
+		return OP_PASS_THROUGH;
+	}
+	return OP_LEAF;
+}
+
+void BTCompiledTree::_lower(BTTask *p_task) {
+	const uint32_t idx = tasks.size();
+	const Opcode op = _get_opcode(p_task);
+
+	tasks.push_back(p_task);
+	opcodes.push_back(op);
+	subtree_end.push_back(idx + 1);
+	cursor.push_back(idx + 1);
+	status.push_back(p_task->get_status());
+	elapsed.push_back(p_task->get_elapsed_time());
+
+	if (op != OP_LEAF) {
+		for (int i = 0; i < p_task->get_child_count(); i++) {
+			_lower(p_task->data.children[i].ptr());
+		}
+	}
+	subtree_end[idx] = tasks.size();
+}
+
+bool BTCompiledTree::compile(const Ref<BTTask> &p_root) {
+	clear();
+	ERR_FAIL_COND_V(p_root.is_null(), false);
+	root = p_root;
+	_lower(root.ptr());
+	_sync_from_tasks();
+	return true;
+}
+
+void BTCompiledTree::clear() {
+	root.unref();
+	tasks.clear();
+	opcodes.clear();
+	subtree_end.clear();
+	cursor.clear();
+	status.clear();
+	elapsed.clear();
+}
+
+void BTCompiledTree::_sync_from_tasks() {
+	for (uint32_t i = 0; i < tasks.size(); i++) {
+		status[i] = tasks[i]->get_status();
+		elapsed[i] = tasks[i]->get_elapsed_time();
+		cursor[i] = i + 1;
+		if (status[i] == BT::RUNNING && (opcodes[i] == OP_SEQUENCE || opcodes[i] == OP_SELECTOR)) {
+			// Resume from the running child, if there is one.
+			for (uint32_t c = i + 1; c < subtree_end[i]; c = subtree_end[c]) {
+				if (tasks[c]->get_status() == BT::RUNNING) {
+					cursor[i] = c;
+					break;
+				}
+			}
+		}
+	}
+}
+
+void BTCompiledTree::_abort_subtree(uint32_t p_idx) {
+	// Mirrors BTTask::abort() for the children of p_idx.
+	for (uint32_t c = p_idx + 1; c < subtree_end[p_idx]; c = subtree_end[c]) {
+		if (opcodes[c] == OP_LEAF) {
+			tasks[c]->abort();
+		} else {
+			_abort_subtree(c);
+			tasks[c]->data.status = BT::FRESH;
+			tasks[c]->data.elapsed = 0.0;
+		}
+		status[c] = BT::FRESH;
+		elapsed[c] = 0.0;
+	}
+}
+
+BT::Status BTCompiledTree::_execute(uint32_t p_idx, double p_delta) {
+	BTTask *task = tasks[p_idx];
+
+	if (opcodes[p_idx] == OP_LEAF) {
+		const BT::Status leaf_status = task->execute(p_delta);
+		status[p_idx] = leaf_status;
+		elapsed[p_idx] = task->get_elapsed_time();
+		return leaf_status;
+	}
+
+#ifdef DEBUG_ENABLED
+	BTProfiler::TaskScope profile_scope(task);
+#endif
+
+	// * Enter.
+	if (status[p_idx] != BT::RUNNING) {
+		if (status[p_idx] != BT::FRESH) {
+			_abort_subtree(p_idx);
+		}
+		cursor[p_idx] = p_idx + 1;
+	} else {
+		elapsed[p_idx] += p_delta;
+	}
+
+	// * Tick.
+	BT::Status result = BT::FAILURE;
+	const uint32_t end = subtree_end[p_idx];
+	switch (opcodes[p_idx]) {
+		case OP_SEQUENCE: {
+			result = BT::SUCCESS;
+			for (uint32_t c = cursor[p_idx]; c < end; c = subtree_end[c]) {
+				result = _execute(c, p_delta);
+				if (result != BT::SUCCESS) {
+					cursor[p_idx] = c;
+					break;
+				}
+			}
+		} break;
+		case OP_SELECTOR: {
+			result = BT::FAILURE;
+			for (uint32_t c = cursor[p_idx]; c < end; c = subtree_end[c]) {
+				result = _execute(c, p_delta);
+				if (result != BT::FAILURE) {
+					cursor[p_idx] = c;
+					break;
+				}
+			}
+		} break;
+		case OP_INVERT: {
+			result = _execute(p_idx + 1, p_delta);
+			if (result == BT::SUCCESS) {
+				result = BT::FAILURE;
+			} else if (result == BT::FAILURE) {
+				result = BT::SUCCESS;
+			}
+		} break;
+		case OP_ALWAYS_SUCCEED: {
+			result = _execute(p_idx + 1, p_delta) == BT::RUNNING ? BT::RUNNING : BT::SUCCESS;
+		} break;
+		case OP_ALWAYS_FAIL: {
+			result = _execute(p_idx + 1, p_delta) == BT::RUNNING ? BT::RUNNING : BT::FAILURE;
+		} break;
+		case OP_PASS_THROUGH: {
+			result = _execute(p_idx + 1, p_delta);
+		} break;
+		case OP_LEAF: {
+			// Handled above.
+		} break;
+	}
+
+	// * Exit.
+	status[p_idx] = result;
+	if (result != BT::RUNNING) {
+		elapsed[p_idx] = 0.0;
+	}
+	task->data.status = result;
+	task->data.elapsed = elapsed[p_idx];
+	return result;
+}
+
+BT::Status BTCompiledTree::execute(double p_delta) {
+	ERR_FAIL_COND_V_MSG(!is_compiled(), BT::FRESH, "BTCompiledTree: Tree is not compiled.");
+	if (unlikely(tasks[0]->get_status() != status[0])) {
+		// Tasks were modified outside of the interpreter (e.g., aborted via BTTask::abort()).
+		_sync_from_tasks();
+	}
+	return _execute(0, p_delta);
+}
+
+void BTCompiledTree::abort() {
+	ERR_FAIL_COND(!is_compiled());
+	root->abort();
+	_sync_from_tasks();
+}
@@ -0,0 +1,85 @@
+/**
+ * bt_compiled_tree.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_COMPILED_TREE_H
+#define BT_COMPILED_TREE_H
+
+#include "tasks/bt_task.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/local_vector.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+/**
+ * Flattened execution form of an initialized task tree.
+ *
+ * Tasks are laid out in pre-order, so that the subtree of the task at index `i`
+ * occupies the range [i, subtree_end[i]) and its first child (if any) is at `i + 1`.
+ * Runtime state of each node is kept in parallel arrays.
+ *
+ * Core composites and decorators are executed directly by the interpreter loop.
+ * Any other task (including scripted tasks) is treated as an opaque leaf and executed
+ * with BTTask::execute(), which takes care of its own subtree.
+ *
+ * Status and elapsed time are written through to the tasks, so that debugger and
+ * BTTask getters keep working. The tree structure must not change after compilation.
+ */
+class BTCompiledTree {
+public:
+	enum Opcode : uint8_t {
+		OP_LEAF, // Executed via BTTask::execute().
+		OP_SEQUENCE,
+		OP_SELECTOR,
+		OP_INVERT,
+		OP_ALWAYS_SUCCEED,
+		OP_ALWAYS_FAIL,
+		OP_PASS_THROUGH, // Returns status of its only child (BTNewScope, BTSubtree).
+	};
+
+private:
+	Ref<BTTask> root; // Keeps the task graph alive.
+
+	LocalVector<BTTask *> tasks;
+	LocalVector<Opcode> opcodes;
+	LocalVector<uint32_t> subtree_end;
+	LocalVector<uint32_t> cursor; // Index of the child to resume from (sequence/selector).
+	LocalVector<BT::Status> status;
+	LocalVector<double> elapsed;
+
+	static Opcode _get_opcode(const BTTask *p_task);
+	void _lower(BTTask *p_task);
+	void _sync_from_tasks();
+	void _abort_subtree(uint32_t p_idx);
+	BT::Status _execute(uint32_t p_idx, double p_delta);
+
+public:
+	bool compile(const Ref<BTTask> &p_root);
+	void clear();
+
+	_FORCE_INLINE_ bool is_compiled() const { return root.is_valid(); }
+	_FORCE_INLINE_ int get_node_count() const { return tasks.size(); }
+	_FORCE_INLINE_ int get_native_node_count() const {
+		int count = 0;
+		for (uint32_t i = 0; i < opcodes.size(); i++) {
+			count += int(opcodes[i] != OP_LEAF);
+		}
+		return count;
+	}
+
+	BT::Status execute(double p_delta);
+	void abort();
+};
+
+#endif // BT_COMPILED_TREE_H
@@ -13,17 +13,23 @@
 
 #include "../editor/debugger/limbo_debugger.h"
 #include "behavior_tree.h"
+#include "bt_profiler.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/io/stream_peer.h"
 #include "core/os/time.h"
 #include "main/performance.h"
 #endif
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/stream_peer_buffer.hpp>
 #include <godot_cpp/classes/time.hpp>
 #endif
 
+#define BT_STATE_MAGIC 0x5354424C // "LBTS"
+#define BT_STATE_FORMAT_VERSION 2
+
 Ref<BTInstance> BTInstance::create(Ref<BTTask> p_root_task, String p_source_bt_path, Node *p_owner_node) {
 	ERR_FAIL_NULL_V(p_root_task, nullptr);
 	ERR_FAIL_NULL_V(p_owner_node, nullptr);
@@ -38,29 +44,120 @@ Ref<BTInstance> BTInstance::create(Ref<BTTask> p_root_task, String p_source_bt_p
 BT::Status BTInstance::update(double p_delta) {
 	ERR_FAIL_COND_V(!root_task.is_valid(), BT::FRESH);
 
-#ifdef DEBUG_ENABLED
-	double start = Time::get_singleton()->get_ticks_usec();
-#endif
-
 	const Ref<BTInstance> keep_alive{ this }; // keep instance alive until update is finished
-	last_status = root_task->execute(p_delta);
+	_update(p_delta);
 	emit_signal(LW_NAME(updated), last_status);
+	return last_status;
+}
 
+BT::Status BTInstance::_update(double p_delta) {
 #ifdef DEBUG_ENABLED
-	double end = Time::get_singleton()->get_ticks_usec();
-	update_time_acc += (end - start);
-	update_time_n += 1.0;
+	BTProfiler::UpdateScope profile_scope(this);
+
+	// Timing is only measured when it is consumed by the performance monitor.
+	if (unlikely(monitor_performance)) {
+		const uint64_t start = Time::get_singleton()->get_ticks_usec();
+		last_status = compiled_execution ? compiled_tree.execute(p_delta) : root_task->execute(p_delta);
+		const uint64_t elapsed = Time::get_singleton()->get_ticks_usec() - start;
+		if (monitor_entry) {
+			BTMonitor::get_singleton()->record(monitor_entry, elapsed);
+		} else {
+			update_time_acc += double(elapsed);
+			update_time_n += 1.0;
+		}
+		return last_status;
+	}
 #endif
+
+	last_status = compiled_execution ? compiled_tree.execute(p_delta) : root_task->execute(p_delta);
 	return last_status;
 }
 
+void BTInstance::_notify_debugger_updated() {
+#ifdef DEBUG_ENABLED
+	// Batched updates skip the signal, except for instances the debugger may track.
+	if (unlikely(registered_with_debugger)) {
+		emit_signal(LW_NAME(updated), last_status);
+	}
+#endif
+}
+
+void BTInstance::save_state(const Ref<StreamPeer> &p_stream) const {
+	ERR_FAIL_COND(!root_task.is_valid() || root_task->get_blackboard().is_null());
+	ERR_FAIL_COND(p_stream.is_null());
+	p_stream->put_u32(BT_STATE_MAGIC);
+	p_stream->put_u8(BT_STATE_FORMAT_VERSION);
+	p_stream->put_u8(last_status);
+	root_task->get_blackboard()->save_state(p_stream, true);
+	root_task->save_state(p_stream);
+}
+
+Error BTInstance::load_state(const Ref<StreamPeer> &p_stream) {
+	ERR_FAIL_COND_V(!root_task.is_valid() || root_task->get_blackboard().is_null(), ERR_UNCONFIGURED);
+	ERR_FAIL_COND_V(p_stream.is_null(), ERR_INVALID_PARAMETER);
+	ERR_FAIL_COND_V_MSG(p_stream->get_u32() != BT_STATE_MAGIC, ERR_FILE_UNRECOGNIZED, "BTInstance: Unrecognized state data.");
+	ERR_FAIL_COND_V_MSG(p_stream->get_u8() != BT_STATE_FORMAT_VERSION, ERR_FILE_UNRECOGNIZED, "BTInstance: Unsupported state format version.");
+	const uint8_t status = p_stream->get_u8();
+	ERR_FAIL_COND_V_MSG(status > BT::SUCCESS, ERR_INVALID_DATA, "BTInstance: Invalid status in state data.");
+
+	// * Tasks are restored as the data is read, so the current state is kept to roll back on failure.
+	Ref<StreamPeerBuffer> backup;
+	backup.instantiate();
+	root_task->get_blackboard()->save_state(backup, true);
+	root_task->save_state(backup);
+
+	Error err = root_task->get_blackboard()->load_state(p_stream);
+	ERR_FAIL_COND_V(err != OK, err);
+	err = root_task->load_state(p_stream);
+	if (unlikely(err != OK)) {
+		backup->seek(0);
+		root_task->get_blackboard()->load_state(backup);
+		root_task->load_state(backup);
+		ERR_FAIL_V_MSG(err, "BTInstance: Failed to load task state. Previous state is restored.");
+	}
+
+	last_status = BT::Status(status);
+	if (compiled_execution) {
+		// Re-derive interpreter cursors from the restored statuses.
+		compiled_tree.compile(root_task);
+	}
+	return OK;
+}
+
+void BTInstance::set_compiled_execution(bool p_enable) {
+	ERR_FAIL_COND(!root_task.is_valid());
+	if (compiled_execution == p_enable) {
+		return;
+	}
+	compiled_execution = p_enable;
+	if (compiled_execution) {
+		compiled_tree.compile(root_task);
+	} else {
+		// Composites don't track interpreter cursors, so the tree is restarted.
+		compiled_tree.abort();
+		compiled_tree.clear();
+	}
+}
+
 void BTInstance::set_monitor_performance(bool p_monitor) {
 #ifdef DEBUG_ENABLED
 	monitor_performance = p_monitor;
+	update_time_acc = 0.0;
+	update_time_n = 0.0;
 	if (monitor_performance) {
-		_add_custom_monitor();
+		if (BTMonitor::get_singleton() && BTMonitor::get_singleton()->is_aggregated()) {
+			if (monitor_entry == nullptr) {
+				monitor_entry = BTMonitor::get_singleton()->acquire(source_bt_path);
+			}
+		} else {
+			_add_custom_monitor();
+		}
 	} else {
 		_remove_custom_monitor();
+		if (monitor_entry) {
+			BTMonitor::get_singleton()->release(monitor_entry);
+			monitor_entry = nullptr;
+		}
 	}
 #endif
 }
@@ -77,6 +174,7 @@ void BTInstance::register_with_debugger() {
 #ifdef DEBUG_ENABLED
 	if (LimboDebugger::get_singleton()->is_active()) {
 		LimboDebugger::get_singleton()->register_bt_instance(get_instance_id());
+		registered_with_debugger = true;
 	}
 #endif
 }
@@ -86,6 +184,7 @@ void BTInstance::unregister_with_debugger() {
 	if (LimboDebugger::get_singleton()->is_active()) {
 		LimboDebugger::get_singleton()->unregister_bt_instance(get_instance_id());
 	}
+	registered_with_debugger = false;
 #endif
 }
 
@@ -136,12 +235,19 @@ void BTInstance::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_monitor_performance", "monitor"), &BTInstance::set_monitor_performance);
 	ClassDB::bind_method(D_METHOD("get_monitor_performance"), &BTInstance::get_monitor_performance);
 
+	ClassDB::bind_method(D_METHOD("set_compiled_execution", "enable"), &BTInstance::set_compiled_execution);
+	ClassDB::bind_method(D_METHOD("get_compiled_execution"), &BTInstance::get_compiled_execution);
+
 	ClassDB::bind_method(D_METHOD("update", "delta"), &BTInstance::update);
 
+	ClassDB::bind_method(D_METHOD("save_state", "stream"), &BTInstance::save_state);
+	ClassDB::bind_method(D_METHOD("load_state", "stream"), &BTInstance::load_state);
+
 	ClassDB::bind_method(D_METHOD("register_with_debugger"), &BTInstance::register_with_debugger);
 	ClassDB::bind_method(D_METHOD("unregister_with_debugger"), &BTInstance::unregister_with_debugger);
 
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_performance"), "set_monitor_performance", "get_monitor_performance");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compiled_execution"), "set_compiled_execution", "get_compiled_execution");
 
 	ADD_SIGNAL(MethodInfo("updated", PropertyInfo(Variant::INT, "status")));
 	ADD_SIGNAL(MethodInfo("freed"));
@@ -151,5 +257,8 @@ BTInstance::~BTInstance() {
 	emit_signal(LW_NAME(freed));
 #ifdef DEBUG_ENABLED
 	_remove_custom_monitor();
+	if (monitor_entry && BTMonitor::get_singleton()) {
+		BTMonitor::get_singleton()->release(monitor_entry);
+	}
 #endif
 }
@@ -11,6 +11,8 @@
 #ifndef BT_INSTANCE_H
 #define BT_INSTANCE_H
 
+#include "bt_compiled_tree.h"
+#include "bt_monitor.h"
 #include "tasks/bt_task.h"
 
 class BTInstance : public RefCounted {
@@ -21,6 +23,8 @@ private:
 	uint64_t owner_node_id = 0;
 	String source_bt_path;
 	BT::Status last_status = BT::FRESH;
+	bool compiled_execution = false;
+	BTCompiledTree compiled_tree;
 
 #ifdef DEBUG_ENABLED
 	bool monitor_performance = false;
@@ -32,8 +36,20 @@ private:
 	void _add_custom_monitor();
 	void _remove_custom_monitor();
 
+	BTMonitor::Entry *monitor_entry = nullptr; // Used when monitors are aggregated per BehaviorTree.
+
+	uint32_t profiled_task_count = 0;
+	uint32_t profiled_layout_hash = 0;
+	friend class BTProfiler;
+
+	bool registered_with_debugger = false;
+
 #endif // * DEBUG_ENABLED
 
+	friend class BTWorld;
+	BT::Status _update(double p_delta);
+	void _notify_debugger_updated();
+
 protected:
 	static void _bind_methods();
 
@@ -53,6 +69,12 @@ public:
 
 	BT::Status update(double p_delta);
 
+	void save_state(const Ref<StreamPeer> &p_stream) const;
+	Error load_state(const Ref<StreamPeer> &p_stream);
+
+	void set_compiled_execution(bool p_enable);
+	bool get_compiled_execution() const { return compiled_execution; }
+
 	void set_monitor_performance(bool p_monitor);
 	bool get_monitor_performance() const;
 
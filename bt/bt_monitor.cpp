@@ -0,0 +1,206 @@
+/**
+ * bt_monitor.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_monitor.h"
+
+#include "../util/limbo_compat.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
+#include "core/config/project_settings.h"
+#include "core/os/time.h"
+#include "main/performance.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/performance.hpp>
+#include <godot_cpp/classes/project_settings.hpp>
+#include <godot_cpp/classes/time.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+#define MONITOR_WINDOW_MIN_USEC 100000 // Reads within this interval share the same window.
+
+static const char *metric_names[BTMonitor::METRIC_MAX] = {
+	"total_ms",
+	"instances",
+	"p50_ms",
+	"p99_ms",
+	"ticks_per_sec",
+};
+
+BTMonitor *BTMonitor::singleton = nullptr;
+
+void BTMonitor::initialize() {
+	ERR_FAIL_COND(singleton != nullptr);
+	memnew(BTMonitor);
+	GLOBAL_DEF(PropertyInfo(Variant::INT, "limbo_ai/behavior_tree/performance_monitors", PROPERTY_HINT_ENUM, "Per Instance,Per Behavior Tree"), 0);
+	singleton->aggregated = int(GLOBAL_GET("limbo_ai/behavior_tree/performance_monitors")) == 1;
+}
+
+void BTMonitor::deinitialize() {
+	if (singleton) {
+		memdelete(singleton);
+	}
+}
+
+void BTMonitor::_lock() {
+#ifdef LIMBOAI_MODULE
+	mutex.lock();
+#elif LIMBOAI_GDEXTENSION
+	mutex->lock();
+#endif
+}
+
+void BTMonitor::_unlock() {
+#ifdef LIMBOAI_MODULE
+	mutex.unlock();
+#elif LIMBOAI_GDEXTENSION
+	mutex->unlock();
+#endif
+}
+
+void BTMonitor::_add_monitors(const String &p_key, const Entry *p_entry) {
+	ERR_FAIL_NULL(Performance::get_singleton());
+	for (int i = 0; i < METRIC_MAX; i++) {
+		StringName id = p_entry->category + "/" + metric_names[i];
+		if (!Performance::get_singleton()->has_custom_monitor(id)) {
+			PERFORMANCE_ADD_CUSTOM_MONITOR(id, callable_mp_static(&BTMonitor::_get_metric).bind(p_key, i));
+		}
+	}
+}
+
+double BTMonitor::_get_percentile_ms(const uint32_t *p_histogram, uint64_t p_count, double p_percentile) {
+	if (p_count == 0) {
+		return 0.0;
+	}
+	const uint64_t target = MAX(uint64_t(1), uint64_t(Math::ceil(p_count * p_percentile)));
+	uint64_t cumulative = 0;
+	for (int b = 0; b < HISTOGRAM_SIZE; b++) {
+		cumulative += p_histogram[b];
+		if (cumulative >= target) {
+			// Upper bound of the bucket.
+			const uint32_t m = b / 2;
+			const uint64_t upper_usec = (b % 2) ? (uint64_t(1) << (m + 1)) : ((uint64_t(3) << m) >> 1);
+			return upper_usec * 0.001;
+		}
+	}
+	return 0.0;
+}
+
+void BTMonitor::_refresh(Entry *p_entry) {
+	const uint64_t now = Time::get_singleton()->get_ticks_usec();
+	if (p_entry->snapshot_time_usec != 0 && now - p_entry->snapshot_time_usec < MONITOR_WINDOW_MIN_USEC) {
+		return;
+	}
+
+	const uint64_t frames = Engine::get_singleton()->get_process_frames();
+	const uint64_t total_usec = p_entry->total_usec.get();
+	const uint64_t updates = p_entry->updates.get();
+
+	const uint64_t d_frames = frames - p_entry->snapshot_frames;
+	const uint64_t d_total_usec = total_usec - p_entry->snapshot_total_usec;
+	const uint64_t d_updates = updates - p_entry->snapshot_updates;
+	const double d_sec = p_entry->snapshot_time_usec ? (now - p_entry->snapshot_time_usec) * 0.000001 : 0.0;
+
+	uint32_t d_histogram[HISTOGRAM_SIZE];
+	uint64_t d_count = 0;
+	for (int b = 0; b < HISTOGRAM_SIZE; b++) {
+		const uint32_t count = p_entry->histogram[b].get();
+		d_histogram[b] = count - p_entry->snapshot_histogram[b];
+		d_count += d_histogram[b];
+		p_entry->snapshot_histogram[b] = count;
+	}
+
+	p_entry->values[METRIC_TOTAL_MS] = d_frames > 0 ? (d_total_usec * 0.001) / d_frames : 0.0;
+	p_entry->values[METRIC_P50_MS] = _get_percentile_ms(d_histogram, d_count, 0.5);
+	p_entry->values[METRIC_P99_MS] = _get_percentile_ms(d_histogram, d_count, 0.99);
+	p_entry->values[METRIC_TICKS_PER_SEC] = d_sec > 0.0 ? d_updates / d_sec : 0.0;
+
+	p_entry->snapshot_time_usec = now;
+	p_entry->snapshot_frames = frames;
+	p_entry->snapshot_total_usec = total_usec;
+	p_entry->snapshot_updates = updates;
+}
+
+double BTMonitor::_get_metric(const String &p_key, int p_metric) {
+	if (singleton == nullptr) {
+		return 0.0;
+	}
+	ERR_FAIL_INDEX_V(p_metric, METRIC_MAX, 0.0);
+
+	Entry *entry = nullptr;
+	if (p_key.is_empty()) {
+		entry = &singleton->global;
+	} else {
+		singleton->_lock();
+		Entry **e = singleton->entries.getptr(p_key);
+		entry = e ? *e : nullptr;
+		singleton->_unlock();
+	}
+	ERR_FAIL_NULL_V(entry, 0.0);
+
+	if (p_metric == METRIC_INSTANCES) {
+		return entry->instances.get();
+	}
+	_refresh(entry);
+	return entry->values[p_metric];
+}
+
+BTMonitor::Entry *BTMonitor::acquire(const String &p_bt_path) {
+	const String key = p_bt_path.is_empty() ? String("<unnamed>") : p_bt_path;
+
+	_lock();
+	Entry *entry = nullptr;
+	Entry **e = entries.getptr(key);
+	const bool is_new = e == nullptr;
+	if (is_new) {
+		entry = memnew(Entry);
+		entry->category = "LimboAI: " + key.get_file();
+		entries.insert(key, entry);
+	} else {
+		entry = *e;
+	}
+	_unlock();
+
+	if (is_new) {
+		_add_monitors(key, entry);
+	}
+	if (global.instances.get() == 0) {
+		_add_monitors(String(), &global);
+	}
+	entry->instances.increment();
+	global.instances.increment();
+	return entry;
+}
+
+void BTMonitor::release(Entry *p_entry) {
+	ERR_FAIL_NULL(p_entry);
+	p_entry->instances.decrement();
+	global.instances.decrement();
+}
+
+BTMonitor::BTMonitor() {
+	singleton = this;
+	global.category = "LimboAI";
+#ifdef LIMBOAI_GDEXTENSION
+	mutex.instantiate();
+#endif
+}
+
+BTMonitor::~BTMonitor() {
+	// Monitors are not removed, as Performance may already be gone at this point.
+	for (const KeyValue<String, Entry *> &kv : entries) {
+		memdelete(kv.value);
+	}
+	entries.clear();
+	singleton = nullptr;
+}
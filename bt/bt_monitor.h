@@ -0,0 +1,128 @@
+/**
+ * bt_monitor.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_MONITOR_H
+#define BT_MONITOR_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/os/mutex.h"
+#include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/safe_refcount.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/mutex.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
+#include <godot_cpp/variant/string.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+/**
+ * Aggregated performance monitors.
+ *
+ * Instead of a custom monitor per BTInstance, update times are accumulated per BehaviorTree
+ * resource path, and in total for all behavior trees. Recording only touches atomic counters,
+ * so it is cheap and safe to do from worker threads. Metrics are computed over the interval
+ * between consecutive reads of the monitors.
+ */
+class BTMonitor {
+public:
+	enum Metric {
+		METRIC_TOTAL_MS, // Update time per frame.
+		METRIC_INSTANCES,
+		METRIC_P50_MS,
+		METRIC_P99_MS,
+		METRIC_TICKS_PER_SEC,
+		METRIC_MAX
+	};
+
+	// Log-scale histogram of update times, two buckets per power of two (microseconds).
+	static constexpr int HISTOGRAM_SIZE = 64;
+
+	struct Entry {
+		String category;
+
+		SafeNumeric<uint64_t> total_usec;
+		SafeNumeric<uint64_t> updates;
+		SafeNumeric<uint32_t> instances;
+		SafeNumeric<uint32_t> histogram[HISTOGRAM_SIZE];
+
+		// * Last read window, only accessed from the main thread.
+		uint64_t snapshot_time_usec = 0;
+		uint64_t snapshot_frames = 0;
+		uint64_t snapshot_total_usec = 0;
+		uint64_t snapshot_updates = 0;
+		uint32_t snapshot_histogram[HISTOGRAM_SIZE] = {};
+		double values[METRIC_MAX] = {};
+	};
+
+private:
+	friend struct BTMonitorTestAccess; // Unit tests.
+
+	static BTMonitor *singleton;
+
+#ifdef LIMBOAI_MODULE
+	Mutex mutex;
+#elif LIMBOAI_GDEXTENSION
+	Ref<Mutex> mutex;
+#endif
+	HashMap<String, Entry *> entries;
+	Entry global; // Totals for all behavior trees; uses empty key.
+	bool aggregated = false;
+
+	void _lock();
+	void _unlock();
+
+	void _add_monitors(const String &p_key, const Entry *p_entry);
+	static void _refresh(Entry *p_entry);
+	static double _get_percentile_ms(const uint32_t *p_histogram, uint64_t p_count, double p_percentile);
+	static double _get_metric(const String &p_key, int p_metric);
+
+	_FORCE_INLINE_ static uint32_t _get_bucket(uint64_t p_usec) {
+		uint32_t msb = 0;
+		for (uint64_t v = p_usec; v > 1; v >>= 1) {
+			msb += 1;
+		}
+		const uint32_t bucket = msb * 2 + uint32_t(p_usec >= ((uint64_t(3) << msb) >> 1));
+		return bucket < HISTOGRAM_SIZE ? bucket : HISTOGRAM_SIZE - 1;
+	}
+
+	_FORCE_INLINE_ static void _record(Entry *p_entry, uint64_t p_usec, uint32_t p_bucket) {
+		p_entry->total_usec.add(p_usec);
+		p_entry->updates.increment();
+		p_entry->histogram[p_bucket].increment();
+	}
+
+public:
+	_FORCE_INLINE_ static BTMonitor *get_singleton() { return singleton; }
+
+	static void initialize();
+	static void deinitialize();
+
+	// Returns true if monitors are aggregated per BehaviorTree resource (see project settings).
+	_FORCE_INLINE_ bool is_aggregated() const { return aggregated; }
+
+	Entry *acquire(const String &p_bt_path);
+	void release(Entry *p_entry);
+
+	_FORCE_INLINE_ void record(Entry *p_entry, uint64_t p_usec) {
+		const uint32_t bucket = _get_bucket(p_usec);
+		_record(p_entry, p_usec, bucket);
+		_record(&global, p_usec, bucket);
+	}
+
+	BTMonitor();
+	~BTMonitor();
+};
+
+#endif // BT_MONITOR_H
@@ -43,6 +43,7 @@
 VARIANT_ENUM_CAST(BTPlayer::UpdateMode);
 
 void BTPlayer::_load_tree() {
+	_unregister_from_world();
 	bt_instance.unref();
 	ERR_FAIL_COND_MSG(!behavior_tree.is_valid(), "BTPlayer: Initialization failed - needs a valid behavior tree.");
 	ERR_FAIL_COND_MSG(!behavior_tree->get_root_task().is_valid(), "BTPlayer: Initialization failed - behavior tree has no valid root task.");
@@ -53,10 +54,36 @@ void BTPlayer::_load_tree() {
 			"BTPlayer: Initialization failed - unable to establish scene root. This is likely due to BTPlayer not being owned by a scene node. Check BTPlayer.set_scene_root_hint().");
 	bt_instance = behavior_tree->instantiate(agent, blackboard, this, scene_root);
 	ERR_FAIL_COND_MSG(bt_instance.is_null(), "BTPlayer: Failed to instantiate behavior tree.");
+	bt_instance->set_compiled_execution(compiled_execution);
 #ifdef DEBUG_ENABLED
 	bt_instance->set_monitor_performance(monitor_performance);
 	bt_instance->register_with_debugger();
 #endif // DEBUG_ENABLED
+	_register_with_world();
+}
+
+void BTPlayer::_register_with_world() {
+	_unregister_from_world();
+	if (world_node.is_empty() || !active || bt_instance.is_null() || !is_inside_tree() || Engine::get_singleton()->is_editor_hint()) {
+		return;
+	}
+	BTWorld *world = Object::cast_to<BTWorld>(get_node_or_null(world_node));
+	ERR_FAIL_NULL_MSG(world, vformat("BTPlayer: Failed to register with BTWorld - can't get BTWorld node with path '%s'.", world_node));
+	world->register_instance(bt_instance);
+	world_instance = bt_instance;
+	world_id = world->get_instance_id();
+}
+
+void BTPlayer::_unregister_from_world() {
+	if (world_instance.is_null()) {
+		return;
+	}
+	BTWorld *world = Object::cast_to<BTWorld>(OBJECT_DB_GET_INSTANCE(world_id));
+	if (world) {
+		world->unregister_instance(world_instance);
+	}
+	world_instance.unref();
+	world_id = ObjectID();
 }
 
 void BTPlayer::_update_blackboard_plan() {
@@ -74,12 +101,14 @@ void BTPlayer::set_bt_instance(const Ref<BTInstance> &p_bt_instance) {
 	ERR_FAIL_COND_MSG(p_bt_instance.is_null(), "BTPlayer: Failed to set behavior tree instance - instance is null.");
 	ERR_FAIL_COND_MSG(!p_bt_instance->is_instance_valid(), "BTPlayer: Failed to set behavior tree instance - instance is not valid.");
 
+	_unregister_from_world();
 	bt_instance = p_bt_instance;
 	blackboard = p_bt_instance->get_blackboard();
 	agent_node = p_bt_instance->get_agent()->get_path();
 
 	blackboard_plan.unref();
 	behavior_tree.unref();
+	_register_with_world();
 }
 
 void BTPlayer::set_scene_root_hint(Node *p_scene_root) {
@@ -129,9 +158,21 @@ void BTPlayer::set_update_mode(UpdateMode p_mode) {
 void BTPlayer::set_active(bool p_active) {
 	active = p_active;
 	bool is_not_editor = !Engine::get_singleton()->is_editor_hint();
-	set_process(update_mode == UpdateMode::IDLE && active && is_not_editor);
-	set_physics_process(update_mode == UpdateMode::PHYSICS && active && is_not_editor);
+	// * When a BTWorld is assigned, it updates the instance instead.
+	bool self_update = active && is_not_editor && world_node.is_empty();
+	set_process(update_mode == UpdateMode::IDLE && self_update);
+	set_physics_process(update_mode == UpdateMode::PHYSICS && self_update);
 	set_process_input(active && is_not_editor);
+	if (is_inside_tree()) {
+		_register_with_world();
+	}
+}
+
+void BTPlayer::set_world_node(const NodePath &p_world_node) {
+	world_node = p_world_node;
+	if (is_node_ready()) {
+		set_active(active);
+	}
 }
 
 void BTPlayer::update(double p_delta) {
@@ -167,6 +208,13 @@ void BTPlayer::set_monitor_performance(bool p_monitor_performance) {
 #endif
 }
 
+void BTPlayer::set_compiled_execution(bool p_enable) {
+	compiled_execution = p_enable;
+	if (bt_instance.is_valid()) {
+		bt_instance->set_compiled_execution(compiled_execution);
+	}
+}
+
 void BTPlayer::_notification(int p_notification) {
 	switch (p_notification) {
 		case NOTIFICATION_PROCESS: {
@@ -201,8 +249,12 @@ void BTPlayer::_notification(int p_notification) {
 				bt_instance->register_with_debugger();
 			}
 #endif // DEBUG_ENABLED
+			if (is_node_ready()) {
+				_register_with_world();
+			}
 		} break;
 		case NOTIFICATION_EXIT_TREE: {
+			_unregister_from_world();
 #ifdef DEBUG_ENABLED
 			if (bt_instance.is_valid()) {
 				bt_instance->set_monitor_performance(false);
@@ -237,6 +289,12 @@ void BTPlayer::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_monitor_performance", "enable"), &BTPlayer::set_monitor_performance);
 	ClassDB::bind_method(D_METHOD("get_monitor_performance"), &BTPlayer::get_monitor_performance);
 
+	ClassDB::bind_method(D_METHOD("set_compiled_execution", "enable"), &BTPlayer::set_compiled_execution);
+	ClassDB::bind_method(D_METHOD("get_compiled_execution"), &BTPlayer::get_compiled_execution);
+
+	ClassDB::bind_method(D_METHOD("set_world_node", "world_node"), &BTPlayer::set_world_node);
+	ClassDB::bind_method(D_METHOD("get_world_node"), &BTPlayer::get_world_node);
+
 	ClassDB::bind_method(D_METHOD("update", "delta"), &BTPlayer::update);
 	ClassDB::bind_method(D_METHOD("restart"), &BTPlayer::restart);
 
@@ -252,6 +310,8 @@ void BTPlayer::_bind_methods() {
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard", PROPERTY_HINT_NONE, "Blackboard", 0), "set_blackboard", "get_blackboard");
 	ADD_PROPERTY(PropertyInfo(Variant::OBJECT, "blackboard_plan", PROPERTY_HINT_RESOURCE_TYPE, "BlackboardPlan", PROPERTY_USAGE_DEFAULT | PROPERTY_USAGE_EDITOR_INSTANTIATE_OBJECT | PROPERTY_USAGE_ALWAYS_DUPLICATE), "set_blackboard_plan", "get_blackboard_plan");
 	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "monitor_performance"), "set_monitor_performance", "get_monitor_performance");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "compiled_execution"), "set_compiled_execution", "get_compiled_execution");
+	ADD_PROPERTY(PropertyInfo(Variant::NODE_PATH, "world_node", PROPERTY_HINT_NODE_PATH_VALID_TYPES, "BTWorld"), "set_world_node", "get_world_node");
 
 	BIND_ENUM_CONSTANT(IDLE);
 	BIND_ENUM_CONSTANT(PHYSICS);
@@ -270,4 +330,5 @@ BTPlayer::BTPlayer() {
 }
 
 BTPlayer::~BTPlayer() {
+	_unregister_from_world();
 }
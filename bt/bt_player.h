@@ -16,6 +16,7 @@
 #include "../blackboard/blackboard_plan.h"
 #include "behavior_tree.h"
 #include "bt_instance.h"
+#include "bt_world.h"
 #include "tasks/bt_task.h"
 
 #ifdef LIMBOAI_MODULE
@@ -45,10 +46,16 @@ private:
 	Ref<Blackboard> blackboard;
 	Node *scene_root_hint = nullptr;
 	bool monitor_performance = false;
+	bool compiled_execution = false;
+	NodePath world_node;
 
 	Ref<BTInstance> bt_instance;
+	Ref<BTInstance> world_instance; // Instance registered with BTWorld.
+	ObjectID world_id;
 
 	void _load_tree();
+	void _register_with_world();
+	void _unregister_from_world();
 	void _update_blackboard_plan();
 	_FORCE_INLINE_ Node *_get_scene_root() const { return scene_root_hint ? scene_root_hint : get_owner(); }
 
@@ -83,6 +90,12 @@ public:
 	void set_monitor_performance(bool p_monitor_performance);
 	bool get_monitor_performance() const { return monitor_performance; }
 
+	void set_compiled_execution(bool p_enable);
+	bool get_compiled_execution() const { return compiled_execution; }
+
+	void set_world_node(const NodePath &p_world_node);
+	NodePath get_world_node() const { return world_node; }
+
 	void update(double p_delta);
 	void restart();
 
@@ -0,0 +1,293 @@
+/**
+ * bt_profiler.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_profiler.h"
+
+#include "bt_instance.h"
+#include "tasks/bt_task.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/io/file_access.h"
+#include "core/os/time.h"
+#include "core/templates/hashfuncs.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/file_access.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/templates/hashfuncs.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+BTProfiler *BTProfiler::singleton = nullptr;
+SafeFlag BTProfiler::enabled;
+
+#ifdef DEBUG_ENABLED
+
+namespace {
+
+struct ProfileFrame {
+	uint32_t index = 0;
+	uint64_t start_usec = 0;
+	uint64_t children_usec = 0;
+};
+
+struct TaskCounters {
+	uint64_t ticks = 0;
+	uint64_t inclusive_usec = 0;
+	uint64_t exclusive_usec = 0;
+};
+
+_FORCE_INLINE_ uint64_t _get_ticks_usec() {
+	return Time::get_singleton()->get_ticks_usec();
+}
+
+// Recording state of a single (possibly nested) BTInstance update.
+struct ProfileContext {
+	BTInstance *instance = nullptr;
+	LocalVector<TaskCounters> counters;
+	LocalVector<ProfileFrame> frames;
+};
+
+// Per-thread, so that instances updated on worker threads don't contend until merging.
+thread_local LocalVector<ProfileContext> contexts;
+
+} // namespace
+
+thread_local uint32_t BTProfiler::update_depth = 0;
+
+uint32_t BTProfiler::_index_tasks(BTTask *p_task, uint32_t p_index, uint32_t &r_layout_hash) {
+	p_task->data.profile_index = p_index;
+	r_layout_hash = hash_murmur3_one_32(String(p_task->get_class()).hash(), r_layout_hash);
+	r_layout_hash = hash_murmur3_one_32(p_task->data.children.size(), r_layout_hash);
+	uint32_t next = p_index + 1;
+	for (int i = 0; i < p_task->data.children.size(); i++) {
+		next = _index_tasks(p_task->data.children[i].ptr(), next, r_layout_hash);
+	}
+	return next;
+}
+
+void BTProfiler::_build_layout(TreeProfile &r_profile, BTTask *p_task, int p_parent) {
+	const int idx = r_profile.tasks.size();
+	TaskRecord rec;
+	rec.name = p_task->get_task_name();
+	rec.parent = p_parent;
+	r_profile.tasks.push_back(rec);
+	for (int i = 0; i < p_task->data.children.size(); i++) {
+		_build_layout(r_profile, p_task->data.children[i].ptr(), idx);
+	}
+}
+
+void BTProfiler::_begin_update(BTInstance *p_instance) {
+	if (p_instance->profiled_task_count == 0) {
+		uint32_t layout_hash = HASH_MURMUR3_SEED;
+		p_instance->profiled_task_count = _index_tasks(p_instance->get_root_task().ptr(), 0, layout_hash);
+		p_instance->profiled_layout_hash = layout_hash;
+	}
+	if (contexts.size() <= update_depth) {
+		contexts.resize(update_depth + 1);
+	}
+	ProfileContext &ctx = contexts[update_depth];
+	ctx.instance = p_instance;
+	ctx.counters.resize(p_instance->profiled_task_count);
+	ctx.frames.clear();
+	update_depth += 1;
+}
+
+void BTProfiler::_end_update() {
+	update_depth -= 1;
+	ProfileContext &ctx = contexts[update_depth];
+
+	if (singleton) {
+		singleton->_lock();
+		TreeProfile &profile = singleton->profiles[ctx.instance->get_source_bt_path()];
+		if (profile.layout_hash != ctx.instance->profiled_layout_hash || profile.tasks.size() != ctx.counters.size()) {
+			// New tree, or a tree with the same path but different structure.
+			profile.tasks.clear();
+			profile.updates = 0;
+			profile.layout_hash = ctx.instance->profiled_layout_hash;
+			_build_layout(profile, ctx.instance->get_root_task().ptr(), -1);
+		}
+		for (uint32_t i = 0; i < ctx.counters.size(); i++) {
+			profile.tasks[i].ticks += ctx.counters[i].ticks;
+			profile.tasks[i].inclusive_usec += ctx.counters[i].inclusive_usec;
+			profile.tasks[i].exclusive_usec += ctx.counters[i].exclusive_usec;
+		}
+		profile.updates += 1;
+		singleton->_unlock();
+	}
+
+	for (uint32_t i = 0; i < ctx.counters.size(); i++) {
+		ctx.counters[i] = TaskCounters();
+	}
+	ctx.instance = nullptr;
+}
+
+void BTProfiler::_begin_task(const BTTask *p_task) {
+	ProfileFrame frame;
+	frame.index = p_task->data.profile_index;
+	frame.start_usec = _get_ticks_usec();
+	contexts[update_depth - 1].frames.push_back(frame);
+}
+
+void BTProfiler::_end_task() {
+	const uint64_t end_usec = _get_ticks_usec();
+	ProfileContext &ctx = contexts[update_depth - 1];
+	ERR_FAIL_COND(ctx.frames.is_empty());
+
+	const ProfileFrame frame = ctx.frames[ctx.frames.size() - 1];
+	ctx.frames.resize(ctx.frames.size() - 1);
+
+	const uint64_t elapsed = end_usec - frame.start_usec;
+	if (likely(frame.index < ctx.counters.size())) {
+		TaskCounters &counters = ctx.counters[frame.index];
+		counters.ticks += 1;
+		counters.inclusive_usec += elapsed;
+		counters.exclusive_usec += elapsed > frame.children_usec ? elapsed - frame.children_usec : 0;
+	}
+	if (!ctx.frames.is_empty()) {
+		ctx.frames[ctx.frames.size() - 1].children_usec += elapsed;
+	}
+}
+
+#endif // DEBUG_ENABLED
+
+void BTProfiler::_lock() {
+#ifdef LIMBOAI_MODULE
+	mutex.lock();
+#elif LIMBOAI_GDEXTENSION
+	mutex->lock();
+#endif
+}
+
+void BTProfiler::_unlock() {
+#ifdef LIMBOAI_MODULE
+	mutex.unlock();
+#elif LIMBOAI_GDEXTENSION
+	mutex->unlock();
+#endif
+}
+
+void BTProfiler::set_enabled(bool p_enabled) {
+#ifdef DEBUG_ENABLED
+	if (p_enabled) {
+		enabled.set();
+	} else {
+		enabled.clear();
+	}
+#else
+	ERR_FAIL_COND_MSG(p_enabled, "BTProfiler: Profiling is only available in debug builds.");
+#endif
+}
+
+void BTProfiler::clear() {
+	_lock();
+	profiles.clear();
+	_unlock();
+}
+
+PackedStringArray BTProfiler::get_profiled_trees() {
+	PackedStringArray paths;
+	_lock();
+	for (const KeyValue<String, TreeProfile> &kv : profiles) {
+		paths.push_back(kv.key);
+	}
+	_unlock();
+	return paths;
+}
+
+Array BTProfiler::get_tree_profile(const String &p_bt_path) {
+	Array arr;
+	_lock();
+	const TreeProfile *profile = profiles.getptr(p_bt_path);
+	if (profile) {
+		for (const TaskRecord &rec : profile->tasks) {
+			Dictionary d;
+			d["name"] = rec.name;
+			d["parent"] = rec.parent;
+			d["ticks"] = rec.ticks;
+			d["inclusive_usec"] = rec.inclusive_usec;
+			d["exclusive_usec"] = rec.exclusive_usec;
+			arr.push_back(d);
+		}
+	}
+	_unlock();
+	return arr;
+}
+
+Array BTProfiler::serialize_tree_profile(const String &p_bt_path) {
+	// Format: [updates, ticks_0, inclusive_usec_0, exclusive_usec_0, ticks_1, ...] with tasks in pre-order.
+	Array arr;
+	_lock();
+	const TreeProfile *profile = profiles.getptr(p_bt_path);
+	if (profile) {
+		arr.push_back(profile->updates);
+		for (const TaskRecord &rec : profile->tasks) {
+			arr.push_back(rec.ticks);
+			arr.push_back(rec.inclusive_usec);
+			arr.push_back(rec.exclusive_usec);
+		}
+	}
+	_unlock();
+	return arr;
+}
+
+String BTProfiler::get_collapsed_stacks() {
+	// Collapsed stack format, as consumed by flame graph tools: "frame;frame;frame value".
+	String result;
+	_lock();
+	for (const KeyValue<String, TreeProfile> &kv : profiles) {
+		const String tree_frame = kv.key.is_empty() ? String("<unnamed>") : kv.key.replace(";", ",");
+		Vector<String> stacks;
+		stacks.resize(kv.value.tasks.size());
+		for (uint32_t i = 0; i < kv.value.tasks.size(); i++) {
+			const TaskRecord &rec = kv.value.tasks[i];
+			// Parents precede their children in pre-order.
+			const String &parent_stack = rec.parent < 0 ? tree_frame : stacks[rec.parent];
+			stacks.write[i] = parent_stack + ";" + rec.name.replace(";", ",");
+			if (rec.ticks > 0) {
+				result += stacks[i] + " " + itos(rec.exclusive_usec) + "\n";
+			}
+		}
+	}
+	_unlock();
+	return result;
+}
+
+Error BTProfiler::save_collapsed_stacks(const String &p_file_path) {
+	Ref<FileAccess> f = FileAccess::open(p_file_path, FileAccess::WRITE);
+	ERR_FAIL_COND_V_MSG(f.is_null(), ERR_CANT_OPEN, "BTProfiler: Can't open file for writing: " + p_file_path);
+	f->store_string(get_collapsed_stacks());
+	return OK;
+}
+
+void BTProfiler::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_enabled", "enabled"), &BTProfiler::set_enabled);
+	ClassDB::bind_method(D_METHOD("is_enabled"), &BTProfiler::is_enabled);
+	ClassDB::bind_method(D_METHOD("clear"), &BTProfiler::clear);
+	ClassDB::bind_method(D_METHOD("get_profiled_trees"), &BTProfiler::get_profiled_trees);
+	ClassDB::bind_method(D_METHOD("get_tree_profile", "bt_path"), &BTProfiler::get_tree_profile);
+	ClassDB::bind_method(D_METHOD("get_collapsed_stacks"), &BTProfiler::get_collapsed_stacks);
+	ClassDB::bind_method(D_METHOD("save_collapsed_stacks", "file_path"), &BTProfiler::save_collapsed_stacks);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "enabled"), "set_enabled", "is_enabled");
+}
+
+BTProfiler::BTProfiler() {
+	singleton = this;
+#ifdef LIMBOAI_GDEXTENSION
+	mutex.instantiate();
+#endif
+}
+
+BTProfiler::~BTProfiler() {
+	enabled.clear();
+	singleton = nullptr;
+}
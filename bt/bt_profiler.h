@@ -0,0 +1,146 @@
+/**
+ * bt_profiler.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_PROFILER_H
+#define BT_PROFILER_H
+
+#ifdef LIMBOAI_MODULE
+#include "core/object/class_db.h"
+#include "core/object/object.h"
+#include "core/os/mutex.h"
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "core/templates/safe_refcount.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/mutex.hpp>
+#include <godot_cpp/classes/object.hpp>
+#include <godot_cpp/core/class_db.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#include <godot_cpp/templates/safe_refcount.hpp>
+using namespace godot;
+#endif // LIMBOAI_GDEXTENSION
+
+class BTTask;
+class BTInstance;
+
+/**
+ * Per-task profiler.
+ *
+ * Records tick counts, as well as inclusive and exclusive execution time of each task.
+ * Time is measured in microseconds with the engine clock.
+ * Tasks are identified by their pre-order position in the tree, and the records are aggregated
+ * across all instances of the same BehaviorTree (keyed by the source resource path, and reset
+ * when the structure of the tree changes).
+ * Recording is only available in debug builds.
+ */
+class BTProfiler : public Object {
+	GDCLASS(BTProfiler, Object);
+
+public:
+	struct TaskRecord {
+		String name;
+		int parent = -1;
+		uint64_t ticks = 0;
+		uint64_t inclusive_usec = 0;
+		uint64_t exclusive_usec = 0;
+	};
+
+	struct TreeProfile {
+		LocalVector<TaskRecord> tasks; // In pre-order.
+		uint64_t updates = 0;
+		uint32_t layout_hash = 0; // Task classes and child counts in pre-order.
+	};
+
+#ifdef DEBUG_ENABLED
+	// Records a profiled update of a BTInstance (no-op if the profiler is disabled).
+	struct UpdateScope {
+		bool active;
+		_FORCE_INLINE_ UpdateScope(BTInstance *p_instance) {
+			active = unlikely(enabled.is_set());
+			if (active) {
+				_begin_update(p_instance);
+			}
+		}
+		_FORCE_INLINE_ ~UpdateScope() {
+			if (active) {
+				_end_update();
+			}
+		}
+	};
+
+	// Records execution of a task (no-op outside of a profiled update).
+	struct TaskScope {
+		bool active;
+		_FORCE_INLINE_ TaskScope(const BTTask *p_task) {
+			active = unlikely(update_depth > 0);
+			if (active) {
+				_begin_task(p_task);
+			}
+		}
+		_FORCE_INLINE_ ~TaskScope() {
+			if (active) {
+				_end_task();
+			}
+		}
+	};
+#endif // DEBUG_ENABLED
+
+private:
+	static BTProfiler *singleton;
+	static SafeFlag enabled;
+
+#ifdef DEBUG_ENABLED
+	static thread_local uint32_t update_depth;
+
+	static void _begin_update(BTInstance *p_instance);
+	static void _end_update();
+	static void _begin_task(const BTTask *p_task);
+	static void _end_task();
+	static uint32_t _index_tasks(BTTask *p_task, uint32_t p_index, uint32_t &r_layout_hash);
+	static void _build_layout(TreeProfile &r_profile, BTTask *p_task, int p_parent);
+#endif // DEBUG_ENABLED
+
+#ifdef LIMBOAI_MODULE
+	Mutex mutex;
+#elif LIMBOAI_GDEXTENSION
+	Ref<Mutex> mutex;
+#endif
+	HashMap<String, TreeProfile> profiles;
+
+	void _lock();
+	void _unlock();
+
+protected:
+	static void _bind_methods();
+
+public:
+	_FORCE_INLINE_ static BTProfiler *get_singleton() { return singleton; }
+
+	void set_enabled(bool p_enabled);
+	_FORCE_INLINE_ bool is_enabled() const { return enabled.is_set(); }
+
+	void clear();
+
+	PackedStringArray get_profiled_trees();
+	Array get_tree_profile(const String &p_bt_path);
+	Array serialize_tree_profile(const String &p_bt_path);
+
+	String get_collapsed_stacks();
+	Error save_collapsed_stacks(const String &p_file_path);
+
+	BTProfiler();
+	~BTProfiler();
+};
+
+#endif // BT_PROFILER_H
@@ -0,0 +1,422 @@
+/**
+ * bt_world.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_world.h"
+
+#include "../blackboard/shared_blackboard.h"
+#include "../util/limbo_compat.h"
+#include "../util/limbo_string_names.h"
+#include "../util/limbo_task_db.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/config/engine.h"
+#include "core/error/error_macros.h"
+#include "core/object/class_db.h"
+#include "core/object/script_language.h"
+#include "core/object/worker_thread_pool.h"
+#include "core/os/os.h"
+#include "core/os/time.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/engine.hpp>
+#include <godot_cpp/classes/os.hpp>
+#include <godot_cpp/classes/script.hpp>
+#include <godot_cpp/classes/time.hpp>
+#include <godot_cpp/classes/worker_thread_pool.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+VARIANT_ENUM_CAST(BTWorld::UpdateMode);
+
+uint32_t BTWorld::_get_or_create_batch(const String &p_source_bt_path) {
+	HashMap<String, uint32_t>::Iterator E = batch_indices.find(p_source_bt_path);
+	if (E) {
+		return E->value;
+	}
+	uint32_t idx = batches.size();
+	batches.resize(idx + 1);
+	batches[idx].source_bt_path = p_source_bt_path;
+	batch_indices.insert(p_source_bt_path, idx);
+	return idx;
+}
+
+void BTWorld::_compact() {
+	for (uint32_t b = 0; b < batches.size(); b++) {
+		LocalVector<Entry> &entries = batches[b].entries;
+		uint32_t write = 0;
+		for (uint32_t read = 0; read < entries.size(); read++) {
+			if (b == cursor_batch && read == cursor_entry) {
+				// Keep round-robin position.
+				cursor_entry = write;
+			}
+			if (entries[read].instance.is_valid()) {
+				if (write != read) {
+					entries[write] = entries[read];
+				}
+				write += 1;
+			}
+		}
+		entries.resize(write);
+	}
+	needs_compaction = false;
+}
+
+BTWorld::Entry &BTWorld::_next_entry() {
+	if (cursor_batch >= batches.size()) {
+		cursor_batch = 0;
+		cursor_entry = 0;
+	}
+	while (cursor_entry >= batches[cursor_batch].entries.size()) {
+		cursor_batch = (cursor_batch + 1) % batches.size();
+		cursor_entry = 0;
+	}
+	cursor_entry += 1;
+	return batches[cursor_batch].entries[cursor_entry - 1];
+}
+
+bool BTWorld::_is_thread_safe(const Ref<BTInstance> &p_instance) {
+	Ref<Blackboard> bb = p_instance->get_blackboard();
+	if (bb.is_null() || !bb->is_isolated()) {
+		return false;
+	}
+	// * Every task in the tree must be registered as thread-safe.
+	const Callable on_script_changed = callable_mp(this, &BTWorld::_on_task_script_changed);
+	LocalVector<BTTask *> stack;
+	stack.push_back(p_instance->get_root_task().ptr());
+	while (!stack.is_empty()) {
+		BTTask *task = stack[stack.size() - 1];
+		stack.resize(stack.size() - 1);
+		// Attaching a script later makes the task unsafe, and removing it may make the task safe again.
+		if (!task->is_connected(LW_NAME(script_changed), on_script_changed)) {
+			task->connect(LW_NAME(script_changed), on_script_changed);
+		}
+		Ref<Script> sc = GET_SCRIPT(task);
+		if (sc.is_valid() || !LimboTaskDB::is_task_thread_safe(task->get_class())) {
+			return false;
+		}
+		for (int i = 0; i < task->get_child_count(); i++) {
+			stack.push_back(task->get_child(i).ptr());
+		}
+	}
+	return true;
+}
+
+void BTWorld::_update_thread_safety(Entry &r_entry) {
+	Ref<Blackboard> bb = r_entry.instance->get_blackboard();
+	r_entry.isolation_version = bb.is_valid() ? bb->get_isolation_version() : 0;
+	r_entry.thread_safe = _is_thread_safe(r_entry.instance);
+}
+
+void BTWorld::_on_task_script_changed() {
+	thread_safety_dirty = true;
+}
+
+void BTWorld::_update_deferred_item(DeferredUpdate &r_item) {
+	const uint64_t start_usec = frame_budget_usec > 0 ? Time::get_singleton()->get_ticks_usec() : 0;
+	r_item.instance->_update(r_item.delta);
+	if (frame_budget_usec > 0) {
+		r_item.cost_usec = Time::get_singleton()->get_ticks_usec() - start_usec;
+	}
+}
+
+void BTWorld::_update_threaded_item(uint32_t p_index) {
+	_update_deferred_item(threaded_updates[p_index]);
+}
+
+#ifdef LIMBOAI_MODULE
+void BTWorld::_update_threaded_item_func(void *p_world, uint32_t p_index) {
+	static_cast<BTWorld *>(p_world)->_update_threaded_item(p_index);
+}
+#endif
+
+void BTWorld::_run_deferred_updates() {
+	// * Thread-safe instances are updated in parallel.
+	if (!threaded_updates.is_empty()) {
+#ifdef LIMBOAI_MODULE
+		WorkerThreadPool::GroupID group = WorkerThreadPool::get_singleton()->add_native_group_task(
+				&BTWorld::_update_threaded_item_func, this, threaded_updates.size(), -1, true, "BTWorld");
+#elif LIMBOAI_GDEXTENSION
+		int64_t group = WorkerThreadPool::get_singleton()->add_group_task(
+				callable_mp(this, &BTWorld::_update_threaded_item), threaded_updates.size(), -1, true, "BTWorld");
+#endif
+		WorkerThreadPool::get_singleton()->wait_for_group_task_completion(group);
+		for (uint32_t i = 0; i < threaded_updates.size(); i++) {
+			threaded_updates[i].instance->_notify_debugger_updated();
+		}
+	}
+
+	// * The rest is updated on the main thread.
+	for (uint32_t i = 0; i < main_thread_updates.size(); i++) {
+		_update_deferred_item(main_thread_updates[i]);
+		main_thread_updates[i].instance->_notify_debugger_updated();
+	}
+
+	// * Measured costs are used to estimate the budget in the following updates.
+	// Indices remain valid, as entries are only compacted after the update.
+	if (frame_budget_usec > 0) {
+		for (const DeferredUpdate &item : threaded_updates) {
+			batches[item.batch_idx].entries[item.entry_idx].cost_usec = item.cost_usec;
+		}
+		for (const DeferredUpdate &item : main_thread_updates) {
+			batches[item.batch_idx].entries[item.entry_idx].cost_usec = item.cost_usec;
+		}
+	}
+	threaded_updates.clear();
+	main_thread_updates.clear();
+}
+
+void BTWorld::set_update_mode(UpdateMode p_mode) {
+	update_mode = p_mode;
+	set_active(active);
+}
+
+void BTWorld::set_active(bool p_active) {
+	active = p_active;
+	bool is_not_editor = !Engine::get_singleton()->is_editor_hint();
+	set_process(update_mode == UpdateMode::IDLE && active && is_not_editor);
+	set_physics_process(update_mode == UpdateMode::PHYSICS && active && is_not_editor);
+}
+
+void BTWorld::set_tick_divisor(int p_divisor) {
+	ERR_FAIL_COND_MSG(p_divisor < 1, "BTWorld: Tick divisor must be at least 1.");
+	tick_divisor = p_divisor;
+}
+
+void BTWorld::set_frame_budget_usec(int p_budget) {
+	ERR_FAIL_COND_MSG(p_budget < 0, "BTWorld: Frame budget can't be negative.");
+	frame_budget_usec = p_budget;
+}
+
+void BTWorld::set_use_threads(bool p_enable) {
+	ERR_FAIL_COND_MSG(updating, "BTWorld: Can't change threading mode during update.");
+	if (p_enable && !use_threads) {
+		// Thread safety is only evaluated while threads are in use.
+		thread_safety_dirty = true;
+	}
+	use_threads = p_enable;
+}
+
+void BTWorld::register_instance(const Ref<BTInstance> &p_instance) {
+	ERR_FAIL_COND_MSG(p_instance.is_null(), "BTWorld: Failed to register instance - instance is null.");
+	ERR_FAIL_COND_MSG(!p_instance->is_instance_valid(), "BTWorld: Failed to register instance - instance is not valid.");
+	if (instance_batch.has(p_instance.ptr())) {
+		return;
+	}
+	uint32_t batch_idx = _get_or_create_batch(p_instance->get_source_bt_path());
+	Entry entry;
+	entry.instance = p_instance;
+	entry.last_update_time = world_time;
+	entry.pending = updating;
+	if (use_threads) {
+		_update_thread_safety(entry);
+	}
+	has_pending = has_pending || updating;
+	batches[batch_idx].entries.push_back(entry);
+	instance_batch.insert(p_instance.ptr(), batch_idx);
+}
+
+void BTWorld::unregister_instance(const Ref<BTInstance> &p_instance) {
+	ERR_FAIL_COND(p_instance.is_null());
+	HashMap<BTInstance *, uint32_t>::Iterator E = instance_batch.find(p_instance.ptr());
+	if (!E) {
+		return;
+	}
+	const uint32_t batch_idx = E->value;
+	LocalVector<Entry> &entries = batches[batch_idx].entries;
+	instance_batch.remove(E);
+
+	uint32_t idx = 0;
+	while (idx < entries.size() && entries[idx].instance != p_instance) {
+		idx += 1;
+	}
+	ERR_FAIL_COND(idx == entries.size());
+	if (updating) {
+		// Removed after the update, so that indices stay valid during iteration.
+		entries[idx].instance.unref();
+		needs_compaction = true;
+	} else {
+		entries.remove_at(idx);
+		if (batch_idx == cursor_batch && idx < cursor_entry) {
+			cursor_entry -= 1;
+		}
+	}
+}
+
+bool BTWorld::has_instance(const Ref<BTInstance> &p_instance) const {
+	return p_instance.is_valid() && instance_batch.has(p_instance.ptr());
+}
+
+int BTWorld::get_batch_count() const {
+	int count = 0;
+	for (const Batch &batch : batches) {
+		count += int(!batch.entries.is_empty());
+	}
+	return count;
+}
+
+void BTWorld::clear_instances() {
+	ERR_FAIL_COND_MSG(updating, "BTWorld: Can't clear instances during update.");
+	batches.clear();
+	batch_indices.clear();
+	instance_batch.clear();
+	needs_compaction = false;
+	cursor_batch = 0;
+	cursor_entry = 0;
+}
+
+void BTWorld::update(double p_delta) {
+	ERR_FAIL_COND_MSG(updating, "BTWorld: Recursive update is not allowed.");
+	updating = true;
+	world_time += p_delta;
+	last_update_count = 0;
+
+	uint32_t num_slots = 0;
+	for (const Batch &batch : batches) {
+		num_slots += batch.entries.size();
+	}
+	const uint32_t num_instances = instance_batch.size();
+	const uint32_t quota = tick_divisor > 1 ? (num_instances + tick_divisor - 1) / tick_divisor : num_instances;
+	const uint64_t start_usec = frame_budget_usec > 0 ? Time::get_singleton()->get_ticks_usec() : 0;
+	// With threads, the budget is spent by queuing updates, using the durations measured in the previous updates.
+	// Threaded updates are assumed to be spread evenly among the available cores.
+	const uint64_t num_workers = use_threads ? MAX(1, OS::get_singleton()->get_processor_count()) : 1;
+	uint64_t estimated_main_usec = 0;
+	uint64_t estimated_threaded_usec = 0;
+
+	if (use_threads && unlikely(thread_safety_dirty)) {
+		thread_safety_dirty = false;
+		for (Batch &batch : batches) {
+			for (Entry &entry : batch.entries) {
+				if (entry.instance.is_valid()) {
+					_update_thread_safety(entry);
+				}
+			}
+		}
+	}
+
+	// * Round-robin: continue from where the previous update stopped.
+	for (uint32_t visited = 0; visited < num_slots && last_update_count < (int)quota; visited++) {
+		Entry &entry = _next_entry();
+
+		// Hold a reference: the instance may be unregistered during its own update.
+		// Instances registered during this update are processed starting with the next one.
+		const Ref<BTInstance> inst = entry.instance;
+		if (unlikely(inst.is_null() || entry.pending)) {
+			continue;
+		}
+		// Skipped frames are accounted for by passing the accumulated delta.
+		const double delta = world_time - entry.last_update_time;
+		entry.last_update_time = world_time;
+		last_update_count += 1;
+
+		if (use_threads) {
+			DeferredUpdate item;
+			item.instance = inst;
+			item.delta = delta;
+			item.batch_idx = cursor_batch;
+			item.entry_idx = cursor_entry - 1;
+			// Variables may have been bound or linked since thread safety was evaluated.
+			const Ref<Blackboard> bb = inst->get_blackboard();
+			if (unlikely(bb.is_valid() && bb->get_isolation_version() != entry.isolation_version)) {
+				_update_thread_safety(entry);
+			}
+			if (entry.thread_safe) {
+				threaded_updates.push_back(item);
+				estimated_threaded_usec += entry.cost_usec;
+			} else {
+				main_thread_updates.push_back(item);
+				estimated_main_usec += entry.cost_usec;
+			}
+			if (frame_budget_usec > 0 &&
+					Time::get_singleton()->get_ticks_usec() - start_usec + estimated_main_usec + estimated_threaded_usec / num_workers >= (uint64_t)frame_budget_usec) {
+				break;
+			}
+			continue;
+		}
+
+		inst->_update(delta);
+		inst->_notify_debugger_updated();
+
+		if (frame_budget_usec > 0 && Time::get_singleton()->get_ticks_usec() - start_usec >= (uint64_t)frame_budget_usec) {
+			break;
+		}
+	}
+
+	if (use_threads) {
+		// Changes to shared scopes are made visible before instances read them from worker threads.
+		SharedBlackboard::publish_pending();
+		_run_deferred_updates();
+	}
+
+	updating = false;
+	if (needs_compaction) {
+		_compact();
+	}
+	if (has_pending) {
+		for (Batch &batch : batches) {
+			for (Entry &entry : batch.entries) {
+				entry.pending = false;
+			}
+		}
+		has_pending = false;
+	}
+}
+
+void BTWorld::_notification(int p_notification) {
+	switch (p_notification) {
+		case NOTIFICATION_PROCESS: {
+			update(get_process_delta_time());
+		} break;
+		case NOTIFICATION_PHYSICS_PROCESS: {
+			update(get_physics_process_delta_time());
+		} break;
+		case NOTIFICATION_READY: {
+			set_active(active);
+		} break;
+	}
+}
+
+void BTWorld::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_update_mode", "update_mode"), &BTWorld::set_update_mode);
+	ClassDB::bind_method(D_METHOD("get_update_mode"), &BTWorld::get_update_mode);
+	ClassDB::bind_method(D_METHOD("set_active", "active"), &BTWorld::set_active);
+	ClassDB::bind_method(D_METHOD("get_active"), &BTWorld::get_active);
+
+	ClassDB::bind_method(D_METHOD("set_tick_divisor", "divisor"), &BTWorld::set_tick_divisor);
+	ClassDB::bind_method(D_METHOD("get_tick_divisor"), &BTWorld::get_tick_divisor);
+	ClassDB::bind_method(D_METHOD("set_frame_budget_usec", "budget_usec"), &BTWorld::set_frame_budget_usec);
+	ClassDB::bind_method(D_METHOD("get_frame_budget_usec"), &BTWorld::get_frame_budget_usec);
+	ClassDB::bind_method(D_METHOD("set_use_threads", "enable"), &BTWorld::set_use_threads);
+	ClassDB::bind_method(D_METHOD("get_use_threads"), &BTWorld::get_use_threads);
+	ClassDB::bind_method(D_METHOD("get_last_update_count"), &BTWorld::get_last_update_count);
+
+	ClassDB::bind_method(D_METHOD("register_instance", "bt_instance"), &BTWorld::register_instance);
+	ClassDB::bind_method(D_METHOD("unregister_instance", "bt_instance"), &BTWorld::unregister_instance);
+	ClassDB::bind_method(D_METHOD("has_instance", "bt_instance"), &BTWorld::has_instance);
+	ClassDB::bind_method(D_METHOD("get_instance_count"), &BTWorld::get_instance_count);
+	ClassDB::bind_method(D_METHOD("get_batch_count"), &BTWorld::get_batch_count);
+	ClassDB::bind_method(D_METHOD("clear_instances"), &BTWorld::clear_instances);
+
+	ClassDB::bind_method(D_METHOD("update", "delta"), &BTWorld::update);
+
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "update_mode", PROPERTY_HINT_ENUM, "Idle,Physics,Manual"), "set_update_mode", "get_update_mode");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "active"), "set_active", "get_active");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "tick_divisor", PROPERTY_HINT_RANGE, "1,60,1,or_greater"), "set_tick_divisor", "get_tick_divisor");
+	ADD_PROPERTY(PropertyInfo(Variant::INT, "frame_budget_usec", PROPERTY_HINT_RANGE, "0,100000,1,or_greater,suffix:usec"), "set_frame_budget_usec", "get_frame_budget_usec");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "use_threads"), "set_use_threads", "get_use_threads");
+
+	BIND_ENUM_CONSTANT(IDLE);
+	BIND_ENUM_CONSTANT(PHYSICS);
+	BIND_ENUM_CONSTANT(MANUAL);
+}
+
+BTWorld::~BTWorld() {
+}
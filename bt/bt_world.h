@@ -0,0 +1,141 @@
+/**
+ * bt_world.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_WORLD_H
+#define BT_WORLD_H
+
+#include "bt_instance.h"
+
+#ifdef LIMBOAI_MODULE
+#include "core/templates/hash_map.h"
+#include "core/templates/local_vector.h"
+#include "scene/main/node.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/node.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/local_vector.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+// Updates many behavior tree instances in a single batched call.
+class BTWorld : public Node {
+	GDCLASS(BTWorld, Node);
+
+public:
+	enum UpdateMode : unsigned int {
+		IDLE, // automatically call update() during NOTIFICATION_PROCESS
+		PHYSICS, // automatically call update() during NOTIFICATION_PHYSICS
+		MANUAL, // manually update instances, user must call update(delta)
+	};
+
+private:
+	struct Entry {
+		Ref<BTInstance> instance;
+		double last_update_time = 0.0;
+		bool pending = false; // Registered during update.
+		bool thread_safe = false;
+		uint64_t isolation_version = 0; // Blackboard state thread_safe was evaluated with.
+		uint64_t cost_usec = 0; // Duration of the last deferred update, used to estimate the frame budget with threads.
+	};
+
+	struct DeferredUpdate {
+		Ref<BTInstance> instance;
+		double delta = 0.0;
+		uint32_t batch_idx = 0;
+		uint32_t entry_idx = 0;
+		uint64_t cost_usec = 0;
+	};
+
+	// Instances created from the same BehaviorTree resource are updated together.
+	struct Batch {
+		String source_bt_path;
+		LocalVector<Entry> entries;
+	};
+
+	UpdateMode update_mode = UpdateMode::PHYSICS;
+	bool active = true;
+	int tick_divisor = 1;
+	int frame_budget_usec = 0;
+	bool use_threads = false;
+
+	LocalVector<Batch> batches;
+	HashMap<String, uint32_t> batch_indices;
+	HashMap<BTInstance *, uint32_t> instance_batch;
+	bool updating = false;
+	bool needs_compaction = false;
+	bool has_pending = false;
+	bool thread_safety_dirty = false; // A task script has changed, or threads were enabled.
+
+	double world_time = 0.0;
+	// Round-robin position of the next entry to update.
+	uint32_t cursor_batch = 0;
+	uint32_t cursor_entry = 0;
+	int last_update_count = 0;
+
+	LocalVector<DeferredUpdate> threaded_updates;
+	LocalVector<DeferredUpdate> main_thread_updates;
+
+	uint32_t _get_or_create_batch(const String &p_source_bt_path);
+	void _compact();
+	Entry &_next_entry();
+
+	bool _is_thread_safe(const Ref<BTInstance> &p_instance);
+	void _update_thread_safety(Entry &r_entry);
+	void _on_task_script_changed();
+	void _update_threaded_item(uint32_t p_index);
+	void _update_deferred_item(DeferredUpdate &r_item);
+	void _run_deferred_updates();
+#ifdef LIMBOAI_MODULE
+	static void _update_threaded_item_func(void *p_world, uint32_t p_index);
+#endif
+
+protected:
+	static void _bind_methods();
+
+	void _notification(int p_notification);
+
+#ifdef LIMBOAI_GDEXTENSION
+	String _to_string() const { return String(get_name()) + ":<" + get_class() + "#" + itos(get_instance_id()) + ">"; }
+#endif
+
+public:
+	void set_update_mode(UpdateMode p_mode);
+	UpdateMode get_update_mode() const { return update_mode; }
+
+	void set_active(bool p_active);
+	bool get_active() const { return active; }
+
+	void set_tick_divisor(int p_divisor);
+	int get_tick_divisor() const { return tick_divisor; }
+
+	void set_frame_budget_usec(int p_budget);
+	int get_frame_budget_usec() const { return frame_budget_usec; }
+
+	void set_use_threads(bool p_enable);
+	bool get_use_threads() const { return use_threads; }
+
+	int get_last_update_count() const { return last_update_count; }
+
+	void register_instance(const Ref<BTInstance> &p_instance);
+	void unregister_instance(const Ref<BTInstance> &p_instance);
+	bool has_instance(const Ref<BTInstance> &p_instance) const;
+	int get_instance_count() const { return instance_batch.size(); }
+	int get_batch_count() const;
+	void clear_instances();
+
+	void update(double p_delta);
+
+	BTWorld() = default;
+	~BTWorld();
+};
+
+#endif // BT_WORLD_H
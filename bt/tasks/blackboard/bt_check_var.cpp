@@ -13,6 +13,7 @@
 
 void BTCheckVar::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	variable_handle = BBHandle(variable);
 	emit_changed();
 }
 
@@ -51,14 +52,25 @@ String BTCheckVar::_generate_name() {
 			value.is_valid() ? Variant(value) : Variant("???"));
 }
 
+void BTCheckVar::_setup() {
+	variable_handle = get_blackboard()->resolve_var(variable);
+	if (value.is_valid()) {
+		value_handle = value->resolve_handle(get_blackboard());
+	}
+}
+
 BT::Status BTCheckVar::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BTCheckVar: `variable` is not set.");
 	ERR_FAIL_COND_V_MSG(!value.is_valid(), FAILURE, "BTCheckVar: `value` is not set.");
 
-	ERR_FAIL_COND_V_MSG(!get_blackboard()->has_var(variable), FAILURE, vformat("BTCheckVar: Blackboard variable doesn't exist: \"%s\". Returning FAILURE.", variable));
+	const Ref<Blackboard> &bb = get_blackboard();
+	if (unlikely(!bb->is_handle_valid(variable_handle))) {
+		variable_handle = bb->resolve_var(variable);
+		ERR_FAIL_COND_V_MSG(!variable_handle.is_resolved(), FAILURE, vformat("BTCheckVar: Blackboard variable doesn't exist: \"%s\". Returning FAILURE.", variable));
+	}
 
-	Variant left_value = get_blackboard()->get_var(variable, Variant());
-	Variant right_value = value->get_value(get_scene_root(), get_blackboard());
+	Variant left_value = bb->get_var_by_handle(variable_handle, Variant());
+	Variant right_value = value->get_value_by_handle(get_scene_root(), bb, value_handle);
 
 	return LimboUtility::get_singleton()->perform_check(check_type, left_value, right_value) ? SUCCESS : FAILURE;
 }
@@ -21,27 +21,36 @@ String BTSetVar::_generate_name() {
 			value.is_valid() ? Variant(value) : Variant("???"));
 }
 
+void BTSetVar::_setup() {
+	variable_handle = get_blackboard()->resolve_var(variable);
+	if (value.is_valid()) {
+		value_handle = value->resolve_handle(get_blackboard());
+	}
+}
+
 BT::Status BTSetVar::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(variable == StringName(), FAILURE, "BTSetVar: `variable` is not set.");
 	ERR_FAIL_COND_V_MSG(!value.is_valid(), FAILURE, "BTSetVar: `value` is not set.");
 	Variant result;
 	Variant error_result = LW_NAME(error_value);
-	Variant right_value = value->get_value(get_scene_root(), get_blackboard(), error_result);
+	const Ref<Blackboard> &bb = get_blackboard();
+	Variant right_value = value->get_value_by_handle(get_scene_root(), bb, value_handle, error_result);
 	ERR_FAIL_COND_V_MSG(right_value == error_result, FAILURE, "BTSetVar: Failed to get parameter value. Returning FAILURE.");
 	if (operation == LimboUtility::OPERATION_NONE) {
 		result = right_value;
 	} else if (operation != LimboUtility::OPERATION_NONE) {
-		Variant left_value = get_blackboard()->get_var(variable, error_result);
+		Variant left_value = bb->get_var_by_handle(variable_handle, error_result);
 		ERR_FAIL_COND_V_MSG(left_value == error_result, FAILURE, vformat("BTSetVar: Failed to get \"%s\" blackboard variable. Returning FAILURE.", variable));
 		result = LimboUtility::get_singleton()->perform_operation(operation, left_value, right_value);
 		ERR_FAIL_COND_V_MSG(result == Variant(), FAILURE, "BTSetVar: Operation not valid. Returning FAILURE.");
 	}
-	get_blackboard()->set_var(variable, result);
+	bb->set_var_by_handle(variable_handle, result);
 	return SUCCESS;
 };
 
 void BTSetVar::set_variable(const StringName &p_variable) {
 	variable = p_variable;
+	variable_handle = BBHandle(variable);
 	emit_changed();
 }
 
@@ -18,9 +18,9 @@
 using namespace godot;
 #endif
 
-Ref<BTTask> BTComment::clone() const {
+Ref<BTTask> BTComment::_clone(bool p_share_params) const {
 	if (Engine::get_singleton()->is_editor_hint()) {
-		return BTTask::clone();
+		return BTTask::_clone(p_share_params);
 	}
 	return nullptr;
 }
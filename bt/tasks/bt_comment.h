@@ -21,8 +21,9 @@ class BTComment : public BTTask {
 protected:
 	static void _bind_methods() {}
 
+	virtual Ref<BTTask> _clone(bool p_share_params) const override;
+
 public:
-	virtual Ref<BTTask> clone() const override;
 	virtual PackedStringArray get_configuration_warnings() override;
 };
 
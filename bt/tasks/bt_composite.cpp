@@ -11,6 +11,109 @@
 
 #include "bt_composite.h"
 
+#include "bt_condition.h"
+#include "composites/bt_dynamic_sequence.h"
+#include "composites/bt_sequence.h"
+
+bool BTComposite::_has_guards(const BTTask *p_branch) {
+	if (!Object::cast_to<BTSequence>(p_branch) && !Object::cast_to<BTDynamicSequence>(p_branch)) {
+		return false;
+	}
+	return p_branch->get_child_count() > 0 && Object::cast_to<BTCondition>(p_branch->get_child(0).ptr());
+}
+
+int BTComposite::_check_guards(const BTTask *p_branch, double p_delta, Status &r_status) {
+	r_status = SUCCESS;
+	int i = 0;
+	while (i < p_branch->get_child_count()) {
+		BTTask *child = p_branch->get_child(i).ptr();
+		if (!Object::cast_to<BTCondition>(child)) {
+			break;
+		}
+		r_status = child->execute(p_delta);
+		i += 1;
+		if (r_status != SUCCESS) {
+			break;
+		}
+	}
+	return i;
+}
+
+void BTComposite::_reuse_checked_guards(BTTask *p_branch, int p_num_checked, Status p_status) {
+	BTComposite *branch = Object::cast_to<BTComposite>(p_branch);
+	ERR_FAIL_NULL(branch);
+	branch->checked_guards = p_num_checked;
+	branch->checked_guards_status = p_status;
+	// Children of a finished branch are reset when it's entered again. The guards were just evaluated, so they are kept as is.
+	if (branch->data.status != RUNNING && branch->data.status != FRESH) {
+		for (int i = p_num_checked; i < branch->get_child_count(); i++) {
+			branch->get_child(i)->abort();
+		}
+		branch->data.status = FRESH;
+	}
+}
+
+bool BTComposite::_are_watched_vars_changed() {
+	if (watched_vars_dirty) {
+		return true;
+	}
+	for (WatchedVar &var : watched_vars) {
+		if (var.blackboard->get_var_version_by_handle(var.handle) != var.version) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void BTComposite::_begin_watching_reads() {
+	read_recorder.reads.clear();
+	Blackboard::push_read_recorder(&read_recorder);
+}
+
+void BTComposite::_end_watching_reads(uint32_t p_num_reads, bool p_append) {
+	Blackboard::pop_read_recorder();
+	if (!p_append) {
+		watched_vars.clear();
+		watched_vars_dirty = false;
+	}
+	for (uint32_t i = 0; i < p_num_reads; i++) {
+		const BBReadRecorder::Read &read = read_recorder.reads[i];
+		bool is_watched = false;
+		for (const WatchedVar &var : watched_vars) {
+			if (var.blackboard.ptr() == read.blackboard && var.handle.name == read.name) {
+				is_watched = true;
+				break;
+			}
+		}
+		if (is_watched) {
+			continue;
+		}
+		WatchedVar var;
+		var.blackboard = Ref<Blackboard>(const_cast<Blackboard *>(read.blackboard));
+		var.handle = read.blackboard->resolve_var(read.name);
+		var.version = read.blackboard->get_var_version_by_handle(var.handle);
+		if (!read.blackboard->is_var_version_tracked_by_handle(var.handle)) {
+			watched_vars_dirty = true;
+		}
+		watched_vars.push_back(var);
+	}
+
+	// Variables read in this subtree are also read by an enclosing reactive composite.
+	BBReadRecorder *outer = read_recorder.outer;
+	if (outer) {
+		for (const BBReadRecorder::Read &read : read_recorder.reads) {
+			outer->reads.push_back(read);
+		}
+		for (const WatchedVar &var : watched_vars) {
+			BBReadRecorder::Read read;
+			read.blackboard = var.blackboard.ptr();
+			read.name = var.handle.name;
+			outer->reads.push_back(read);
+		}
+	}
+	read_recorder.reads.clear();
+}
+
 PackedStringArray BTComposite::get_configuration_warnings() {
 	PackedStringArray warnings = BTTask::get_configuration_warnings();
 	if (get_child_count_excluding_comments() < 1) {
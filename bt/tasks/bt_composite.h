@@ -17,9 +17,53 @@
 class BTComposite : public BTTask {
 	GDCLASS(BTComposite, BTTask);
 
+private:
+	// Guards of this branch already evaluated by the parent composite in the current tick.
+	int checked_guards = 0;
+	Status checked_guards_status = SUCCESS;
+
+	// Blackboard variables read by the children preceding the running one, with their versions.
+	struct WatchedVar {
+		Ref<Blackboard> blackboard;
+		BBHandle handle;
+		uint32_t version = 0;
+	};
+	LocalVector<WatchedVar> watched_vars;
+	bool watched_vars_dirty = true; // Changes of the watched variables can't be detected.
+	BBReadRecorder read_recorder;
+
 protected:
 	static void _bind_methods() {}
 
+	// * Guards are the leading BTCondition children of a sequence branch: if any of them fails, so does the branch.
+	static bool _has_guards(const BTTask *p_branch);
+	// Evaluates guards of a branch up to the first one that doesn't succeed.
+	// Returns the number of evaluated guards, and the result of the last one in r_status.
+	static int _check_guards(const BTTask *p_branch, double p_delta, Status &r_status);
+	// Makes the branch reuse results of _check_guards() when it's executed in the same tick, instead of ticking the guards again.
+	// Must be called right before executing the branch: it also resets the rest of its children if the branch has finished before.
+	static void _reuse_checked_guards(BTTask *p_branch, int p_num_checked, Status p_status);
+
+	// Used by sequences at the start of _tick(): returns the number of guards already checked by the parent (0 if none),
+	// and the result of the last one in r_status.
+	_FORCE_INLINE_ int _take_checked_guards(Status &r_status) {
+		const int num_checked = checked_guards;
+		r_status = checked_guards_status;
+		checked_guards = 0;
+		checked_guards_status = SUCCESS;
+		return num_checked;
+	}
+
+	// * Reactive evaluation: children preceding the running one are only reevaluated when variables they've read change.
+	// Returns true if any of the watched variables changed since they were read.
+	bool _are_watched_vars_changed();
+	void _invalidate_watched_vars() { watched_vars_dirty = true; }
+	// Records variables read on this thread until _end_watching_reads().
+	void _begin_watching_reads();
+	// Watches variables among the first p_num_reads recorded reads. If p_append is true, previously watched variables are kept.
+	void _end_watching_reads(uint32_t p_num_reads, bool p_append);
+	_FORCE_INLINE_ uint32_t _get_num_recorded_reads() const { return read_recorder.reads.size(); }
+
 public:
 	virtual PackedStringArray get_configuration_warnings() override;
 };
@@ -15,9 +15,11 @@
 #include "../../util/limbo_string_names.h"
 #include "../../util/limbo_utility.h"
 #include "../behavior_tree.h"
+#include "../bt_profiler.h"
 #include "bt_comment.h"
 
 #ifdef LIMBOAI_MODULE
+#include "core/debugger/engine_debugger.h"
 #include "core/error/error_macros.h"
 #include "core/io/resource.h"
 #include "core/object/class_db.h"
@@ -37,10 +39,13 @@
 #include "godot_cpp/variant/typed_array.hpp"
 #include "godot_cpp/variant/utility_functions.hpp"
 #include "godot_cpp/variant/variant.hpp"
+#include <godot_cpp/classes/engine_debugger.hpp>
 #include <godot_cpp/classes/ref.hpp>
 #include <godot_cpp/classes/script.hpp>
 #endif // LIMBOAI_GDEXTENSION
 
+HashMap<uint64_t, BTTask::ScriptVirtuals> BTTask::script_virtuals;
+
 void BT::_bind_methods() {
 	BIND_ENUM_CONSTANT(FRESH);
 	BIND_ENUM_CONSTANT(RUNNING);
@@ -91,9 +96,10 @@ void BTTask::_set_children(Array p_children) {
 			continue;
 		}
 		if (task->data.parent != nullptr && task->data.parent != this) {
-			task = task->clone();
+			// * BBParams are made unique afterwards, if needed (see _clone()).
+			task = task->_clone(true);
 			if (task.is_null()) {
-				// * BTComment::clone() returns nullptr at runtime - we omit those.
+				// * BTComment::_clone() returns nullptr at runtime - we omit those.
 				num_null += 1;
 				continue;
 			}
@@ -125,8 +131,7 @@ String BTTask::get_task_name() {
 	Ref<Script> task_script = get_script();
 
 	if (task_script.is_valid()) {
-		// ! CURSED: Currently, has_method() doesn't return true for ClassDB-registered native virtual methods. This may break in the future.
-		bool has_generate_method = has_method(LW_NAME(_generate_name));
+		bool has_generate_method = _get_script_virtuals(task_script).generates_name;
 		ERR_FAIL_COND_V_MSG(has_generate_method && !task_script->is_tool(), _generate_name(), vformat("BTTask: @tool annotation is required if _generate_name is defined: %s", task_script->get_path()));
 		if (task_script->is_tool() && has_generate_method) {
 			String call_result;
@@ -172,24 +177,100 @@ void BTTask::initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node
 		get_child(i)->initialize(p_agent, p_blackboard, p_scene_root);
 	}
 
+	_update_script_overrides();
 	_setup();
-	GDVIRTUAL_CALL(_setup);
+	if (data.script_overrides & SCRIPT_SETUP) {
+		GDVIRTUAL_CALL(_setup);
+	}
 }
 
-Ref<BTTask> BTTask::clone() const {
+uint8_t BTTask::_resolve_script_overrides() const {
+	uint8_t overrides = 0;
+	overrides |= GDVIRTUAL_IS_OVERRIDDEN(_setup) ? SCRIPT_SETUP : 0;
+	overrides |= GDVIRTUAL_IS_OVERRIDDEN(_enter) ? SCRIPT_ENTER : 0;
+	overrides |= GDVIRTUAL_IS_OVERRIDDEN(_exit) ? SCRIPT_EXIT : 0;
+	overrides |= GDVIRTUAL_IS_OVERRIDDEN(_tick) ? SCRIPT_TICK : 0;
+	return overrides;
+}
+
+// Scripts are edited without reloading in the editor, and reloaded live from the editor when debugging.
+// Reloads don't always emit "changed", so overrides can't be cached in either case.
+static bool _can_scripts_change() {
+	return Engine::get_singleton()->is_editor_hint() || IS_DEBUGGER_ACTIVE();
+}
+
+BTTask::ScriptVirtuals BTTask::_get_script_virtuals(const Ref<Script> &p_script) {
+	const uint64_t script_id = p_script->get_instance_id();
+	const bool use_cache = !_can_scripts_change();
+	if (use_cache) {
+		const ScriptVirtuals *cached = script_virtuals.getptr(script_id);
+		if (cached) {
+			return *cached;
+		}
+	}
+
+	ScriptVirtuals sv;
+	sv.overrides = _resolve_script_overrides();
+	// ! CURSED: Currently, has_method() doesn't return true for ClassDB-registered native virtual methods. This may break in the future.
+	sv.generates_name = has_method(LW_NAME(_generate_name));
+
+	if (use_cache) {
+		script_virtuals.insert(script_id, sv);
+		// Reloaded scripts are resolved again.
+		Callable on_changed = callable_mp_static(&BTTask::_on_script_changed).bind(script_id);
+		if (!p_script->is_connected(LW_NAME(changed), on_changed)) {
+			p_script->connect(LW_NAME(changed), on_changed, CONNECT_ONE_SHOT);
+		}
+	}
+	return sv;
+}
+
+void BTTask::_on_script_changed(uint64_t p_script_id) {
+	script_virtuals.erase(p_script_id);
+}
+
+void BTTask::clear_script_cache() {
+	script_virtuals.clear();
+}
+
+void BTTask::_update_script_overrides() {
+	// Most tasks are native and have no overrides, so execute() can skip the script virtual calls entirely.
+	// Note: A script attached after initialization will not receive execution callbacks.
+	Ref<Script> task_script = GET_SCRIPT(this);
+	if (task_script.is_valid() && unlikely(_can_scripts_change())) {
+		// A reloaded script may gain overrides, so all script virtuals are called.
+		data.script_overrides = SCRIPT_ALL;
+	} else if (task_script.is_valid()) {
+		data.script_overrides = _get_script_virtuals(task_script).overrides;
+	} else {
+		data.script_overrides = _resolve_script_overrides();
+	}
+}
+
+Ref<BTTask> BTTask::_clone(bool p_share_params) const {
 	Ref<BTTask> inst = duplicate(false);
 
 	// * Children are duplicated via children property. See _set_children().
 
-	// * Make BBParam properties unique.
+	if (!p_share_params && inst.is_valid()) {
+		inst->_make_params_unique();
+	}
+	return inst;
+}
+
+void BTTask::_make_params_unique() {
+	for (const Ref<BTTask> &child : data.children) {
+		child->_make_params_unique();
+	}
+
 	HashMap<Ref<Resource>, Ref<Resource>> duplicates;
 #ifdef LIMBOAI_MODULE
 	List<PropertyInfo> props;
-	inst->get_property_list(&props);
+	get_property_list(&props);
 	for (List<PropertyInfo>::Element *E = props.front(); E; E = E->next()) {
 		PropertyInfo prop = E->get();
 #elif LIMBOAI_GDEXTENSION
-	TypedArray<Dictionary> props = inst->get_property_list();
+	TypedArray<Dictionary> props = get_property_list();
 	for (int i = 0; i < props.size(); i++) {
 		PropertyInfo prop = PropertyInfo::from_dict(props[i]);
 #endif
@@ -197,7 +278,7 @@ Ref<BTTask> BTTask::clone() const {
 			continue;
 		}
 
-		Variant prop_value = inst->get(prop.name);
+		Variant prop_value = get(prop.name);
 		Ref<Resource> res = prop_value;
 		if (res.is_valid() && res->is_class("BBParam")) {
 			// Duplicate BBParam
@@ -205,7 +286,7 @@ Ref<BTTask> BTTask::clone() const {
 				duplicates[res] = res->duplicate();
 			}
 			res = duplicates[res];
-			inst->set(prop.name, res);
+			set(prop.name, res);
 		} else if (prop_value.get_type() == Variant::ARRAY) {
 			// Duplicate BBParams instances inside an array.
 			// - This code doesn't handle arrays of arrays.
@@ -222,11 +303,21 @@ Ref<BTTask> BTTask::clone() const {
 			}
 		}
 	}
+}
 
-	return inst;
+Ref<BTTask> BTTask::clone() const {
+	return _clone(false);
+}
+
+Ref<BTTask> BTTask::clone_shared() const {
+	return _clone(true);
 }
 
 BT::Status BTTask::execute(double p_delta) {
+#ifdef DEBUG_ENABLED
+	BTProfiler::TaskScope profile_scope(this);
+#endif
+
 	if (data.status != RUNNING) {
 		// Reset children status.
 		if (data.status != FRESH) {
@@ -236,18 +327,22 @@ BT::Status BTTask::execute(double p_delta) {
 		}
 		// First native, then script.
 		_enter();
-		GDVIRTUAL_CALL(_enter);
+		if (data.script_overrides & SCRIPT_ENTER) {
+			GDVIRTUAL_CALL(_enter);
+		}
 	} else {
 		data.elapsed += p_delta;
 	}
 
-	if (!GDVIRTUAL_CALL(_tick, p_delta, data.status)) {
+	if (!(data.script_overrides & SCRIPT_TICK) || !GDVIRTUAL_CALL(_tick, p_delta, data.status)) {
 		data.status = _tick(p_delta);
 	}
 
 	if (data.status != RUNNING) {
 		// First script, then native.
-		GDVIRTUAL_CALL(_exit);
+		if (data.script_overrides & SCRIPT_EXIT) {
+			GDVIRTUAL_CALL(_exit);
+		}
 		_exit();
 		data.elapsed = 0.0;
 	}
@@ -260,13 +355,42 @@ void BTTask::abort() {
 	}
 	if (data.status == RUNNING) {
 		// First script, then native.
-		GDVIRTUAL_CALL(_exit);
+		if (data.script_overrides & SCRIPT_EXIT) {
+			GDVIRTUAL_CALL(_exit);
+		}
 		_exit();
 	}
 	data.status = FRESH;
 	data.elapsed = 0.0;
 }
 
+void BTTask::save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_u8(data.status);
+	p_stream->put_double(data.elapsed);
+	_save_state(p_stream);
+	p_stream->put_u32(data.children.size());
+	for (int i = 0; i < data.children.size(); i++) {
+		data.children[i]->save_state(p_stream);
+	}
+}
+
+Error BTTask::load_state(const Ref<StreamPeer> &p_stream) {
+	// Note: State is restored as is, without calling _enter() or _exit().
+	const uint8_t status = p_stream->get_u8();
+	ERR_FAIL_COND_V_MSG(status > SUCCESS, ERR_INVALID_DATA, "BTTask: Invalid status in state data.");
+	data.status = Status(status);
+	data.elapsed = p_stream->get_double();
+	Error err = _load_state(p_stream);
+	ERR_FAIL_COND_V(err != OK, err);
+	const uint32_t child_count = p_stream->get_u32();
+	ERR_FAIL_COND_V_MSG(child_count != uint32_t(data.children.size()), ERR_INVALID_DATA, "BTTask: State data doesn't match the tree structure.");
+	for (int i = 0; i < data.children.size(); i++) {
+		err = data.children.get(i)->load_state(p_stream);
+		ERR_FAIL_COND_V(err != OK, err);
+	}
+	return OK;
+}
+
 int BTTask::get_child_count_excluding_comments() const {
 	int count = 0;
 	for (int i = 0; i < data.children.size(); i++) {
@@ -400,6 +524,7 @@ void BTTask::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("get_root"), &BTTask::get_root);
 	ClassDB::bind_method(D_METHOD("initialize", "agent", "blackboard", "scene_root"), &BTTask::initialize);
 	ClassDB::bind_method(D_METHOD("clone"), &BTTask::clone);
+	ClassDB::bind_method(D_METHOD("clone_shared"), &BTTask::clone_shared);
 	ClassDB::bind_method(D_METHOD("execute", "delta"), &BTTask::execute);
 	ClassDB::bind_method(D_METHOD("get_child", "idx"), &BTTask::get_child);
 	ClassDB::bind_method(D_METHOD("get_child_count"), &BTTask::get_child_count);
@@ -26,6 +26,7 @@
 #include "core/object/ref_counted.h"
 #include "core/os/memory.h"
 #include "core/string/ustring.h"
+#include "core/templates/hash_map.h"
 #include "core/templates/vector.h"
 #include "core/typedefs.h"
 #include "core/variant/array.h"
@@ -39,6 +40,7 @@
 #include <godot_cpp/classes/resource.hpp>
 #include <godot_cpp/core/gdvirtual.gen.inc>
 #include <godot_cpp/core/object.hpp>
+#include <godot_cpp/templates/hash_map.hpp>
 #include <godot_cpp/templates/vector.hpp>
 using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
@@ -72,6 +74,19 @@ class BTTask : public BT {
 
 private:
 	friend class BehaviorTree;
+	friend class BTComposite;
+	friend class BTCompiledTree;
+	friend class BTProfiler;
+	friend struct BTTaskTestAccess; // Unit tests.
+
+	// Script overrides of the execution virtuals, resolved in initialize().
+	enum ScriptOverride : uint8_t {
+		SCRIPT_SETUP = 1 << 0,
+		SCRIPT_ENTER = 1 << 1,
+		SCRIPT_EXIT = 1 << 2,
+		SCRIPT_TICK = 1 << 3,
+		SCRIPT_ALL = SCRIPT_SETUP | SCRIPT_ENTER | SCRIPT_EXIT | SCRIPT_TICK,
+	};
 
 	// Avoid namespace pollution in the derived classes.
 	struct Data {
@@ -85,8 +100,13 @@ private:
 		Status status = FRESH;
 		double elapsed = 0.0;
 		bool display_collapsed = false;
+		// Until initialized, all script virtuals are called.
+		uint8_t script_overrides = SCRIPT_ALL;
 #ifdef TOOLS_ENABLED
 		ObjectID behavior_tree_id;
+#endif
+#ifdef DEBUG_ENABLED
+		uint32_t profile_index = 0; // Pre-order position in the tree, assigned by BTProfiler.
 #endif
 	} data;
 
@@ -95,15 +115,35 @@ private:
 
 	PackedStringArray _get_configuration_warnings(); // ! Scripts only.
 
+	// Resolved script virtuals, shared by all tasks using the same script.
+	struct ScriptVirtuals {
+		uint8_t overrides = 0;
+		bool generates_name = false;
+	};
+	static HashMap<uint64_t, ScriptVirtuals> script_virtuals; // Script instance ID => resolved virtuals.
+
+	uint8_t _resolve_script_overrides() const;
+	ScriptVirtuals _get_script_virtuals(const Ref<Script> &p_script);
+	static void _on_script_changed(uint64_t p_script_id);
+	void _update_script_overrides();
+	void _make_params_unique();
+
 protected:
 	static void _bind_methods();
 
+	// Duplicates the task with its children. Unless p_share_params is set, BBParam resources are made unique.
+	virtual Ref<BTTask> _clone(bool p_share_params) const;
+
 	virtual String _generate_name();
 	virtual void _setup() {}
 	virtual void _enter() {}
 	virtual void _exit() {}
 	virtual Status _tick(double p_delta) { return FAILURE; }
 
+	// Saves/restores runtime state of the task, other than status and elapsed time (see save_state()).
+	virtual void _save_state(const Ref<StreamPeer> &p_stream) const {}
+	virtual Error _load_state(const Ref<StreamPeer> &p_stream) { return OK; }
+
 	GDVIRTUAL0RC(String, _generate_name);
 	GDVIRTUAL0(_setup);
 	GDVIRTUAL0(_enter);
@@ -136,13 +176,20 @@ public:
 
 	Ref<BTTask> get_root() const;
 
-	virtual Ref<BTTask> clone() const;
+	Ref<BTTask> clone() const;
+	Ref<BTTask> clone_shared() const;
 	virtual void initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, Node *p_scene_root);
 	virtual PackedStringArray get_configuration_warnings(); // ! Native version.
 
 	Status execute(double p_delta);
 	void abort();
 
+	// Discards script virtuals resolved for all scripts. Tasks that are already initialized are not affected.
+	static void clear_script_cache();
+
+	void save_state(const Ref<StreamPeer> &p_stream) const;
+	Error load_state(const Ref<StreamPeer> &p_stream);
+
 	_FORCE_INLINE_ Ref<BTTask> get_parent() const { return Ref<BTTask>(data.parent); }
 	_FORCE_INLINE_ bool is_root() const { return data.parent == nullptr; }
 	_FORCE_INLINE_ Ref<Blackboard> get_blackboard() const { return data.blackboard; }
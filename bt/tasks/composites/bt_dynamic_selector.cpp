@@ -15,15 +15,55 @@ void BTDynamicSelector::_enter() {
 	last_running_idx = 0;
 }
 
+void BTDynamicSelector::set_reactive(bool p_reactive) {
+	reactive = p_reactive;
+	emit_changed();
+}
+
+void BTDynamicSelector::set_guarded(bool p_guarded) {
+	guarded = p_guarded;
+	emit_changed();
+}
+
 BT::Status BTDynamicSelector::_tick(double p_delta) {
+	int start = 0;
+	// Reevaluation of preceding tasks is skipped if none of the variables they've read has changed since.
+	const bool skip_preceding = reactive && last_running_idx < get_child_count() &&
+			get_child(last_running_idx)->get_status() == RUNNING && !_are_watched_vars_changed();
+	if (skip_preceding) {
+		start = last_running_idx;
+	}
+	if (reactive) {
+		_begin_watching_reads();
+	}
+
+	// In guarded mode, branches preceding the running one are only executed if their guards pass.
+	const int guarded_end = guarded && last_running_idx < get_child_count() && get_child(last_running_idx)->get_status() == RUNNING ? last_running_idx : 0;
+
 	Status status = SUCCESS;
+	uint32_t num_preceding_reads = 0;
 	int i;
-	for (i = 0; i < get_child_count(); i++) {
-		status = get_child(i)->execute(p_delta);
+	for (i = start; i < get_child_count(); i++) {
+		// Reads of the last executed child are not watched, as it's either running, or decides the outcome.
+		num_preceding_reads = reactive ? _get_num_recorded_reads() : 0;
+		Ref<BTTask> child = get_child(i);
+		if (i < guarded_end && _has_guards(child.ptr())) {
+			Status guard_status;
+			const int num_checked = _check_guards(child.ptr(), p_delta, guard_status);
+			if (guard_status != SUCCESS) {
+				status = FAILURE;
+				continue;
+			}
+			_reuse_checked_guards(child.ptr(), num_checked, guard_status);
+		}
+		status = child->execute(p_delta);
 		if (status != FAILURE) {
 			break;
 		}
 	}
+	if (reactive) {
+		_end_watching_reads(i == get_child_count() ? _get_num_recorded_reads() : num_preceding_reads, skip_preceding);
+	}
 	// If the last node ticked is earlier in the tree than the previous runner,
 	// cancel previous runner.
 	if (last_running_idx > i && get_child(last_running_idx)->get_status() == RUNNING) {
@@ -32,3 +72,25 @@ BT::Status BTDynamicSelector::_tick(double p_delta) {
 	last_running_idx = i;
 	return status;
 }
+
+void BTDynamicSelector::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(last_running_idx);
+}
+
+Error BTDynamicSelector::_load_state(const Ref<StreamPeer> &p_stream) {
+	const int idx = p_stream->get_32();
+	ERR_FAIL_COND_V_MSG(idx < 0 || (idx > 0 && idx >= get_child_count()), ERR_INVALID_DATA, "BTDynamicSelector: Invalid child index in state data.");
+	last_running_idx = idx;
+	_invalidate_watched_vars(); // Force reevaluation on the next tick.
+	return OK;
+}
+
+void BTDynamicSelector::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("set_reactive", "reactive"), &BTDynamicSelector::set_reactive);
+	ClassDB::bind_method(D_METHOD("is_reactive"), &BTDynamicSelector::is_reactive);
+	ClassDB::bind_method(D_METHOD("set_guarded", "guarded"), &BTDynamicSelector::set_guarded);
+	ClassDB::bind_method(D_METHOD("is_guarded"), &BTDynamicSelector::is_guarded);
+
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "reactive"), "set_reactive", "is_reactive");
+	ADD_PROPERTY(PropertyInfo(Variant::BOOL, "guarded"), "set_guarded", "is_guarded");
+}
@@ -20,12 +20,23 @@ class BTDynamicSelector : public BTComposite {
 
 private:
 	int last_running_idx = 0;
+	bool reactive = false;
+	bool guarded = false;
 
 protected:
-	static void _bind_methods() {}
+	static void _bind_methods();
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual void _save_state(const Ref<StreamPeer> &p_stream) const override;
+	virtual Error _load_state(const Ref<StreamPeer> &p_stream) override;
+
+public:
+	void set_reactive(bool p_reactive);
+	bool is_reactive() const { return reactive; }
+
+	void set_guarded(bool p_guarded);
+	bool is_guarded() const { return guarded; }
 };
 
 #endif // BT_DYNAMIC_SELECTOR_H
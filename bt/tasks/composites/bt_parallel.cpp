@@ -11,40 +11,106 @@
 
 #include "bt_parallel.h"
 
-void BTParallel::_enter() {
+void BTParallel::_collect_children() {
+	children.resize(get_child_count());
 	for (int i = 0; i < get_child_count(); i++) {
-		get_child(i)->abort();
+		children[i] = get_child(i).ptr();
 	}
 }
 
+void BTParallel::_activate_all() {
+	active = children;
+	num_succeeded = 0;
+	num_failed = 0;
+}
+
+void BTParallel::_setup() {
+	_collect_children();
+}
+
+void BTParallel::_enter() {
+	if (unlikely(children.size() != uint32_t(get_child_count()))) {
+		// Not initialized, or children changed since.
+		_collect_children();
+	}
+	for (BTTask *child : children) {
+		child->abort();
+	}
+	_activate_all();
+}
+
 BT::Status BTParallel::_tick(double p_delta) {
-	int num_succeeded = 0;
-	int num_failed = 0;
-	BT::Status return_status = RUNNING;
-	for (int i = 0; i < get_child_count(); i++) {
-		Status status = BT::FRESH;
-		Ref<BTTask> child = get_child(i);
-		if (!repeat && (child->get_status() == FAILURE || child->get_status() == SUCCESS)) {
-			status = child->get_status();
-		} else {
-			status = child->execute(p_delta);
+	if (repeat) {
+		// Finished children are executed again, and results are counted per tick.
+		_activate_all();
+	}
+
+	// Finished children are removed from the active list in place, preserving execution order.
+	uint32_t num_running = 0;
+	for (uint32_t i = 0; i < active.size(); i++) {
+		BTTask *child = active[i];
+		const Status status = child->execute(p_delta);
+		if (status == RUNNING) {
+			active[num_running++] = child;
+			continue;
 		}
+
+		Status outcome = RUNNING;
 		if (status == FAILURE) {
 			num_failed += 1;
-			if (num_failed >= num_failures_required && return_status == RUNNING) {
-				return_status = FAILURE;
+			if (num_failed >= num_failures_required) {
+				outcome = FAILURE;
 			}
 		} else if (status == SUCCESS) {
 			num_succeeded += 1;
-			if (num_succeeded >= num_successes_required && return_status == RUNNING) {
-				return_status = SUCCESS;
+			if (num_succeeded >= num_successes_required) {
+				outcome = SUCCESS;
+			}
+		}
+
+		if (outcome != RUNNING) {
+			// Outcome is decided: terminate running children, and skip the rest.
+			for (uint32_t j = 0; j < num_running; j++) {
+				active[j]->abort();
+			}
+			for (uint32_t j = i + 1; j < active.size(); j++) {
+				if (active[j]->get_status() == RUNNING) {
+					active[j]->abort();
+				}
 			}
+			active.clear();
+			return outcome;
 		}
 	}
-	if (!repeat && (num_failed + num_succeeded) == get_child_count() && return_status == RUNNING) {
-		return_status = FAILURE;
+	active.resize(num_running);
+
+	if (!repeat && active.is_empty()) {
+		// All children finished without meeting the criteria.
+		return FAILURE;
+	}
+	return RUNNING;
+}
+
+void BTParallel::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(num_succeeded);
+	p_stream->put_32(num_failed);
+	p_stream->put_u32(active.size());
+	for (const BTTask *child : active) {
+		p_stream->put_u32(child->get_index());
+	}
+}
+
+Error BTParallel::_load_state(const Ref<StreamPeer> &p_stream) {
+	num_succeeded = p_stream->get_32();
+	num_failed = p_stream->get_32();
+	const uint32_t num_active = p_stream->get_u32();
+	active.clear();
+	for (uint32_t i = 0; i < num_active; i++) {
+		const int idx = p_stream->get_u32();
+		ERR_FAIL_COND_V_MSG(idx >= get_child_count(), ERR_INVALID_DATA, "BTParallel: Invalid child index in state data.");
+		active.push_back(get_child(idx).ptr());
 	}
-	return return_status;
+	return OK;
 }
 
 void BTParallel::_bind_methods() {
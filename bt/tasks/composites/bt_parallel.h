@@ -23,11 +23,24 @@ private:
 	int num_failures_required = 1;
 	bool repeat = false;
 
+	// All children, collected once, so that the active list can be refilled without touching the refs.
+	LocalVector<BTTask *> children;
+	// Children that haven't finished yet, in execution order.
+	LocalVector<BTTask *> active;
+	int num_succeeded = 0;
+	int num_failed = 0;
+
+	void _collect_children();
+	void _activate_all();
+
 protected:
 	static void _bind_methods();
 
+	virtual void _setup() override;
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual void _save_state(const Ref<StreamPeer> &p_stream) const override;
+	virtual Error _load_state(const Ref<StreamPeer> &p_stream) override;
 
 public:
 	int get_num_successes_required() const { return num_successes_required; }
@@ -116,6 +116,29 @@ void BTProbabilitySelector::_select_task() {
 	}
 }
 
+void BTProbabilitySelector::_save_state(const Ref<StreamPeer> &p_stream) const {
+	// Tasks are stored as child indices.
+	p_stream->put_32(selected_task.is_valid() ? selected_task->get_index() : -1);
+	p_stream->put_u32(failed_tasks.size());
+	for (const Ref<BTTask> &task : failed_tasks) {
+		p_stream->put_32(task->get_index());
+	}
+}
+
+Error BTProbabilitySelector::_load_state(const Ref<StreamPeer> &p_stream) {
+	const int selected_idx = p_stream->get_32();
+	selected_task = (selected_idx >= 0 && selected_idx < get_child_count()) ? get_child(selected_idx) : Ref<BTTask>();
+	failed_tasks.clear();
+	const uint32_t num_failed = p_stream->get_u32();
+	for (uint32_t i = 0; i < num_failed; i++) {
+		const int idx = p_stream->get_32();
+		if (idx >= 0 && idx < get_child_count()) {
+			failed_tasks.insert(get_child(idx));
+		}
+	}
+	return OK;
+}
+
 //***** Godot
 
 void BTProbabilitySelector::_bind_methods() {
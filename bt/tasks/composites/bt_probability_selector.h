@@ -58,6 +58,8 @@ protected:
 	virtual void _enter() override;
 	virtual void _exit() override;
 	virtual Status _tick(double p_delta) override;
+	virtual void _save_state(const Ref<StreamPeer> &p_stream) const override;
+	virtual Error _load_state(const Ref<StreamPeer> &p_stream) override;
 
 public:
 	double get_weight(int p_index) const;
@@ -27,6 +27,8 @@ protected:
 
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual void _save_state(const Ref<StreamPeer> &p_stream) const override;
+	virtual Error _load_state(const Ref<StreamPeer> &p_stream) override;
 };
 
 #endif // BT_RANDOM_SELECTOR_H
@@ -33,3 +33,25 @@ BT::Status BTRandomSequence::_tick(double p_delta) {
 	}
 	return status;
 }
+
+void BTRandomSequence::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(last_running_idx);
+	p_stream->put_var(indicies);
+}
+
+Error BTRandomSequence::_load_state(const Ref<StreamPeer> &p_stream) {
+	const int idx = p_stream->get_32();
+	ERR_FAIL_COND_V_MSG(idx < 0 || (idx > 0 && idx >= get_child_count()), ERR_INVALID_DATA, "BTRandomSequence: Invalid child index in state data.");
+	const Variant order = p_stream->get_var();
+	ERR_FAIL_COND_V_MSG(order.get_type() != Variant::ARRAY, ERR_INVALID_DATA, "BTRandomSequence: Invalid child order in state data.");
+	const Array order_arr = order;
+	// Order is empty until the task is entered for the first time.
+	ERR_FAIL_COND_V_MSG(!order_arr.is_empty() && order_arr.size() != get_child_count(), ERR_INVALID_DATA, "BTRandomSequence: Child order in state data doesn't match the number of children.");
+	for (int i = 0; i < order_arr.size(); i++) {
+		const Variant &child_idx = order_arr[i];
+		ERR_FAIL_COND_V_MSG(child_idx.get_type() != Variant::INT || int(child_idx) < 0 || int(child_idx) >= get_child_count(), ERR_INVALID_DATA, "BTRandomSequence: Invalid child order in state data.");
+	}
+	last_running_idx = idx;
+	indicies = order_arr;
+	return OK;
+}
@@ -26,3 +26,14 @@ BT::Status BTSelector::_tick(double p_delta) {
 	}
 	return status;
 }
+
+void BTSelector::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(last_running_idx);
+}
+
+Error BTSelector::_load_state(const Ref<StreamPeer> &p_stream) {
+	const int idx = p_stream->get_32();
+	ERR_FAIL_COND_V_MSG(idx < 0 || (idx > 0 && idx >= get_child_count()), ERR_INVALID_DATA, "BTSelector: Invalid child index in state data.");
+	last_running_idx = idx;
+	return OK;
+}
@@ -16,8 +16,14 @@ void BTSequence::_enter() {
 }
 
 BT::Status BTSequence::_tick(double p_delta) {
-	Status status = SUCCESS;
-	for (int i = last_running_idx; i < get_child_count(); i++) {
+	Status status;
+	const int num_prechecked = _take_checked_guards(status);
+	if (unlikely(num_prechecked > 0 && status != SUCCESS)) {
+		// Guards were already evaluated by the parent composite in this tick.
+		last_running_idx = num_prechecked - 1;
+		return status;
+	}
+	for (int i = MAX(last_running_idx, num_prechecked); i < get_child_count(); i++) {
 		status = get_child(i)->execute(p_delta);
 		if (status != SUCCESS) {
 			last_running_idx = i;
@@ -26,3 +32,14 @@ BT::Status BTSequence::_tick(double p_delta) {
 	}
 	return status;
 }
+
+void BTSequence::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(last_running_idx);
+}
+
+Error BTSequence::_load_state(const Ref<StreamPeer> &p_stream) {
+	const int idx = p_stream->get_32();
+	ERR_FAIL_COND_V_MSG(idx < 0 || (idx > 0 && idx >= get_child_count()), ERR_INVALID_DATA, "BTSequence: Invalid child index in state data.");
+	last_running_idx = idx;
+	return OK;
+}
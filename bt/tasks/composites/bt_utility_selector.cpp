@@ -0,0 +1,277 @@
+/**
+ * bt_utility_selector.cpp
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#include "bt_utility_selector.h"
+
+bool BTUtilitySelector::has_weight(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, get_child_count(), false);
+	return !IS_CLASS(get_child(p_index), BTComment);
+}
+
+double BTUtilitySelector::get_weight(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, get_child_count(), 0.0);
+	ERR_FAIL_COND_V(IS_CLASS(get_child(p_index), BTComment), 0.0);
+	return _get_weight(p_index);
+}
+
+void BTUtilitySelector::set_weight(int p_index, double p_weight) {
+	ERR_FAIL_INDEX(p_index, get_child_count());
+	ERR_FAIL_COND(IS_CLASS(get_child(p_index), BTComment));
+	ERR_FAIL_COND(p_weight < 0.0);
+	_set_weight(p_index, p_weight);
+}
+
+void BTUtilitySelector::set_consideration(int p_index, const StringName &p_var, const Ref<Curve> &p_curve) {
+	ERR_FAIL_INDEX(p_index, get_child_count());
+	ERR_FAIL_COND(IS_CLASS(get_child(p_index), BTComment));
+	Ref<BTTask> child = get_child(p_index);
+	if (p_var == StringName()) {
+		child->remove_meta(LW_NAME(_utility_var_));
+	} else {
+		child->set_meta(LW_NAME(_utility_var_), p_var);
+	}
+	if (p_curve.is_null()) {
+		child->remove_meta(LW_NAME(_utility_curve_));
+	} else {
+		child->set_meta(LW_NAME(_utility_curve_), p_curve);
+	}
+	child->emit_signal(LW_NAME(changed));
+}
+
+StringName BTUtilitySelector::get_consideration_var(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, get_child_count(), StringName());
+	return get_child(p_index)->get_meta(LW_NAME(_utility_var_), StringName());
+}
+
+Ref<Curve> BTUtilitySelector::get_consideration_curve(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, get_child_count(), Ref<Curve>());
+	return get_child(p_index)->get_meta(LW_NAME(_utility_curve_), Ref<Curve>());
+}
+
+double BTUtilitySelector::get_score(int p_index) const {
+	ERR_FAIL_INDEX_V(p_index, get_child_count(), 0.0);
+	for (uint32_t k = 0; k < considerations.size(); k++) {
+		if (considerations[k].child_idx == p_index) {
+			return scores[k];
+		}
+	}
+	return 0.0;
+}
+
+void BTUtilitySelector::set_hysteresis(double p_hysteresis) {
+	hysteresis = p_hysteresis;
+	emit_changed();
+}
+
+void BTUtilitySelector::set_rescore_interval(double p_interval) {
+	rescore_interval = p_interval;
+	emit_changed();
+}
+
+void BTUtilitySelector::_setup() {
+	considerations.clear();
+	input_handles.clear();
+	for (int i = 0; i < get_child_count(); i++) {
+		if (IS_CLASS(get_child(i), BTComment)) {
+			continue;
+		}
+		Consideration c;
+		c.child_idx = i;
+		c.weight = _get_weight(i);
+		c.curve = get_consideration_curve(i);
+		const StringName var = get_consideration_var(i);
+		if (var != StringName()) {
+			c.input_idx = input_handles.size();
+			// Handles are validated once here, so that rescoring doesn't complain about missing variables on every tick.
+			BBHandle handle = get_blackboard()->resolve_var(var);
+			if (!handle.is_resolved()) {
+				ERR_PRINT(vformat("BTUtilitySelector: Consideration variable \"%s\" not found in the blackboard. Its utility input is 0 until the variable is created.", var));
+				handle = BBHandle(var);
+			}
+			input_handles.push_back(handle);
+		}
+		considerations.push_back(c);
+	}
+	inputs.resize(input_handles.size());
+	scores.resize(considerations.size());
+	failed.resize(considerations.size());
+	for (uint32_t k = 0; k < scores.size(); k++) {
+		scores[k] = 0.0;
+	}
+}
+
+void BTUtilitySelector::_rescore() {
+	// Inputs of all children are read in a single pass, and then mapped through response curves.
+	if (!input_handles.is_empty()) {
+		get_blackboard()->get_scalars_by_handles(input_handles.ptr(), inputs.ptr(), input_handles.size(), false);
+	}
+	for (uint32_t k = 0; k < considerations.size(); k++) {
+		const Consideration &c = considerations[k];
+		double utility = 1.0;
+		if (c.input_idx >= 0) {
+			const double x = inputs[c.input_idx];
+			utility = c.curve.is_valid() ? c.curve->sample_baked(x) : x;
+		}
+		scores[k] = c.weight * utility;
+	}
+	time_since_scoring = 0.0;
+}
+
+int BTUtilitySelector::_pick_best() const {
+	// Tasks with zero utility are never selected.
+	int best = -1;
+	double best_score = 0.0;
+	for (uint32_t k = 0; k < considerations.size(); k++) {
+		if (failed[k]) {
+			continue;
+		}
+		// Favor the current choice to avoid flip-flopping between tasks with similar scores.
+		const double score = int(k) == selected ? scores[k] + hysteresis : scores[k];
+		if (score > best_score) {
+			best = k;
+			best_score = score;
+		}
+	}
+	return best;
+}
+
+void BTUtilitySelector::_enter() {
+	for (uint32_t k = 0; k < failed.size(); k++) {
+		failed[k] = false;
+	}
+	selected = -1;
+	_rescore();
+}
+
+void BTUtilitySelector::_exit() {
+	selected = -1;
+}
+
+BT::Status BTUtilitySelector::_tick(double p_delta) {
+	if (selected == -1) {
+		selected = _pick_best();
+	} else {
+		time_since_scoring += p_delta;
+		if (time_since_scoring >= rescore_interval) {
+			_rescore();
+			const int best = _pick_best();
+			if (best != -1 && best != selected) {
+				get_child(considerations[selected].child_idx)->abort();
+				selected = best;
+			}
+		}
+	}
+
+	while (selected != -1) {
+		Status status = get_child(considerations[selected].child_idx)->execute(p_delta);
+		if (status != FAILURE) {
+			return status;
+		}
+		failed[selected] = true;
+		selected = _pick_best();
+	}
+	return FAILURE;
+}
+
+void BTUtilitySelector::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(selected);
+	p_stream->put_double(time_since_scoring);
+	p_stream->put_u32(considerations.size());
+	for (uint32_t k = 0; k < considerations.size(); k++) {
+		p_stream->put_double(scores[k]);
+		p_stream->put_u8(failed[k]);
+	}
+}
+
+Error BTUtilitySelector::_load_state(const Ref<StreamPeer> &p_stream) {
+	const int sel = p_stream->get_32();
+	ERR_FAIL_COND_V_MSG(sel < -1 || sel >= int(considerations.size()), ERR_INVALID_DATA, "BTUtilitySelector: Invalid selected task in state data.");
+	const double time = p_stream->get_double();
+	const uint32_t count = p_stream->get_u32();
+	ERR_FAIL_COND_V_MSG(count != considerations.size(), ERR_INVALID_DATA, "BTUtilitySelector: State data doesn't match the number of scored tasks.");
+	selected = sel;
+	time_since_scoring = time;
+	for (uint32_t k = 0; k < count; k++) {
+		scores[k] = p_stream->get_double();
+		failed[k] = p_stream->get_u8();
+	}
+	return OK;
+}
+
+//***** Godot
+
+bool BTUtilitySelector::_set(const StringName &p_name, const Variant &p_value) {
+	// * Considerations are edited as "considerations/<child_idx>/<variable|curve>", and stored as metadata of child tasks.
+	const String name = p_name;
+	if (!name.begins_with("considerations/")) {
+		return false;
+	}
+	const int idx = name.get_slicec('/', 1).to_int();
+	if (idx < 0 || idx >= get_child_count()) {
+		return false;
+	}
+	const String what = name.get_slicec('/', 2);
+	if (what == "variable") {
+		set_consideration(idx, p_value, get_consideration_curve(idx));
+	} else if (what == "curve") {
+		set_consideration(idx, get_consideration_var(idx), p_value);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+bool BTUtilitySelector::_get(const StringName &p_name, Variant &r_ret) const {
+	const String name = p_name;
+	if (!name.begins_with("considerations/")) {
+		return false;
+	}
+	const int idx = name.get_slicec('/', 1).to_int();
+	if (idx < 0 || idx >= get_child_count()) {
+		return false;
+	}
+	const String what = name.get_slicec('/', 2);
+	if (what == "variable") {
+		r_ret = get_consideration_var(idx);
+	} else if (what == "curve") {
+		r_ret = get_consideration_curve(idx);
+	} else {
+		return false;
+	}
+	return true;
+}
+
+void BTUtilitySelector::_get_property_list(List<PropertyInfo> *p_list) const {
+	for (int i = 0; i < get_child_count(); i++) {
+		if (IS_CLASS(get_child(i), BTComment)) {
+			continue;
+		}
+		p_list->push_back(PropertyInfo(Variant::STRING_NAME, "considerations/" + itos(i) + "/variable", PROPERTY_HINT_NONE, "", PROPERTY_USAGE_EDITOR));
+		p_list->push_back(PropertyInfo(Variant::OBJECT, "considerations/" + itos(i) + "/curve", PROPERTY_HINT_RESOURCE_TYPE, "Curve", PROPERTY_USAGE_EDITOR));
+	}
+}
+
+void BTUtilitySelector::_bind_methods() {
+	ClassDB::bind_method(D_METHOD("has_weight", "child_idx"), &BTUtilitySelector::has_weight);
+	ClassDB::bind_method(D_METHOD("get_weight", "child_idx"), &BTUtilitySelector::get_weight);
+	ClassDB::bind_method(D_METHOD("set_weight", "child_idx", "weight"), &BTUtilitySelector::set_weight);
+	ClassDB::bind_method(D_METHOD("set_consideration", "child_idx", "var", "curve"), &BTUtilitySelector::set_consideration, DEFVAL(Ref<Curve>()));
+	ClassDB::bind_method(D_METHOD("get_consideration_var", "child_idx"), &BTUtilitySelector::get_consideration_var);
+	ClassDB::bind_method(D_METHOD("get_consideration_curve", "child_idx"), &BTUtilitySelector::get_consideration_curve);
+	ClassDB::bind_method(D_METHOD("get_score", "child_idx"), &BTUtilitySelector::get_score);
+	ClassDB::bind_method(D_METHOD("set_hysteresis", "hysteresis"), &BTUtilitySelector::set_hysteresis);
+	ClassDB::bind_method(D_METHOD("get_hysteresis"), &BTUtilitySelector::get_hysteresis);
+	ClassDB::bind_method(D_METHOD("set_rescore_interval", "interval"), &BTUtilitySelector::set_rescore_interval);
+	ClassDB::bind_method(D_METHOD("get_rescore_interval"), &BTUtilitySelector::get_rescore_interval);
+
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "hysteresis", PROPERTY_HINT_RANGE, "0,10,0.01,or_greater"), "set_hysteresis", "get_hysteresis");
+	ADD_PROPERTY(PropertyInfo(Variant::FLOAT, "rescore_interval", PROPERTY_HINT_RANGE, "0,60,0.01,or_greater,suffix:s"), "set_rescore_interval", "get_rescore_interval");
+}
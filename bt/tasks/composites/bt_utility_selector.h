@@ -0,0 +1,92 @@
+/**
+ * bt_utility_selector.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef BT_UTILITY_SELECTOR_H
+#define BT_UTILITY_SELECTOR_H
+
+#include "../../../util/limbo_compat.h"
+#include "../bt_comment.h"
+#include "../bt_composite.h"
+
+#ifdef LIMBOAI_MODULE
+#include "scene/resources/curve.h"
+#endif // LIMBOAI_MODULE
+
+#ifdef LIMBOAI_GDEXTENSION
+#include <godot_cpp/classes/curve.hpp>
+#endif // LIMBOAI_GDEXTENSION
+
+class BTUtilitySelector : public BTComposite {
+	GDCLASS(BTUtilitySelector, BTComposite);
+	TASK_CATEGORY(Composites);
+
+private:
+	// Scoring data of a child task, cached in _setup().
+	struct Consideration {
+		int child_idx = -1;
+		int input_idx = -1; // Index in inputs, or -1 if the score doesn't depend on a variable.
+		double weight = 1.0;
+		Ref<Curve> curve;
+	};
+
+	double hysteresis = 0.1;
+	double rescore_interval = 0.0;
+
+	LocalVector<Consideration> considerations;
+	LocalVector<BBHandle> input_handles;
+	LocalVector<double> inputs;
+	LocalVector<double> scores;
+	LocalVector<bool> failed;
+	int selected = -1; // Index in considerations.
+	double time_since_scoring = 0.0;
+
+	_FORCE_INLINE_ double _get_weight(int p_index) const { return get_child(p_index)->get_meta(LW_NAME(_weight_), 1.0); }
+	_FORCE_INLINE_ void _set_weight(int p_index, double p_weight) {
+		get_child(p_index)->set_meta(LW_NAME(_weight_), Variant(p_weight));
+		get_child(p_index)->emit_signal(LW_NAME(changed));
+	}
+
+	void _rescore();
+	int _pick_best() const;
+
+protected:
+	static void _bind_methods();
+
+	bool _set(const StringName &p_name, const Variant &p_value);
+	bool _get(const StringName &p_name, Variant &r_ret) const;
+	void _get_property_list(List<PropertyInfo> *p_list) const;
+
+	virtual void _setup() override;
+	virtual void _enter() override;
+	virtual void _exit() override;
+	virtual Status _tick(double p_delta) override;
+	virtual void _save_state(const Ref<StreamPeer> &p_stream) const override;
+	virtual Error _load_state(const Ref<StreamPeer> &p_stream) override;
+
+public:
+	bool has_weight(int p_index) const;
+	double get_weight(int p_index) const;
+	void set_weight(int p_index, double p_weight);
+
+	void set_consideration(int p_index, const StringName &p_var, const Ref<Curve> &p_curve = Ref<Curve>());
+	StringName get_consideration_var(int p_index) const;
+	Ref<Curve> get_consideration_curve(int p_index) const;
+
+	double get_score(int p_index) const;
+
+	void set_hysteresis(double p_hysteresis);
+	double get_hysteresis() const { return hysteresis; }
+
+	void set_rescore_interval(double p_interval);
+	double get_rescore_interval() const { return rescore_interval; }
+};
+
+#endif // BT_UTILITY_SELECTOR_H
@@ -90,6 +90,24 @@ void BTCooldown::_on_timeout() {
 	timer.unref();
 }
 
+void BTCooldown::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_double(timer.is_valid() ? timer->get_time_left() : 0.0);
+}
+
+Error BTCooldown::_load_state(const Ref<StreamPeer> &p_stream) {
+	const double time_left = p_stream->get_double();
+	if (time_left > 0.0) {
+		_chill();
+		if (timer.is_valid()) {
+			timer->set_time_left(time_left);
+		}
+	} else if (timer.is_valid()) {
+		timer->disconnect(LW_NAME(timeout), callable_mp(this, &BTCooldown::_on_timeout));
+		timer.unref();
+	}
+	return OK;
+}
+
 //**** Godot
 
 void BTCooldown::_bind_methods() {
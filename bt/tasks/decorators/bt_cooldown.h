@@ -44,6 +44,8 @@ protected:
 	virtual String _generate_name() override;
 	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
+	virtual void _save_state(const Ref<StreamPeer> &p_stream) const override;
+	virtual Error _load_state(const Ref<StreamPeer> &p_stream) override;
 
 public:
 	void set_duration(double p_value);
@@ -22,11 +22,13 @@
 
 void BTForEach::set_array_var(const StringName &p_value) {
 	array_var = p_value;
+	array_handle = BBHandle(array_var);
 	emit_changed();
 }
 
 void BTForEach::set_save_var(const StringName &p_value) {
 	save_var = p_value;
+	save_handle = BBHandle(save_var);
 	emit_changed();
 }
 
@@ -38,6 +40,11 @@ String BTForEach::_generate_name() {
 			LimboUtility::get_singleton()->decorate_var(array_var));
 }
 
+void BTForEach::_setup() {
+	array_handle = get_blackboard()->resolve_var(array_var);
+	save_handle = get_blackboard()->resolve_var(save_var);
+}
+
 void BTForEach::_enter() {
 	current_idx = 0;
 }
@@ -47,7 +54,8 @@ BT::Status BTForEach::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(save_var == StringName(), FAILURE, "BTForEach: Save variable is not set.");
 	ERR_FAIL_COND_V_MSG(array_var == StringName(), FAILURE, "BTForEach: Array variable is not set.");
 
-	Array arr = get_blackboard()->get_var(array_var, Variant());
+	const Ref<Blackboard> &bb = get_blackboard();
+	Array arr = bb->get_var_by_handle(array_handle, Variant());
 	if (current_idx >= arr.size()) {
 		if (current_idx != 0) {
 			WARN_PRINT("BTForEach: Array size changed during iteration.");
@@ -55,7 +63,7 @@ BT::Status BTForEach::_tick(double p_delta) {
 		return SUCCESS;
 	}
 	Variant elem = arr[current_idx];
-	get_blackboard()->set_var(save_var, elem);
+	bb->set_var_by_handle(save_handle, elem);
 
 	Status status = get_child(0)->execute(p_delta);
 	if (status == RUNNING) {
@@ -70,6 +78,15 @@ BT::Status BTForEach::_tick(double p_delta) {
 	}
 }
 
+void BTForEach::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(current_idx);
+}
+
+Error BTForEach::_load_state(const Ref<StreamPeer> &p_stream) {
+	current_idx = p_stream->get_32();
+	return OK;
+}
+
 //**** Godot
 
 void BTForEach::_bind_methods() {
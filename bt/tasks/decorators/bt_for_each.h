@@ -14,6 +14,8 @@
 
 #include "../bt_decorator.h"
 
+#include "../../../blackboard/blackboard.h"
+
 class BTForEach : public BTDecorator {
 	GDCLASS(BTForEach, BTDecorator);
 	TASK_CATEGORY(Decorators);
@@ -22,14 +24,20 @@ private:
 	StringName array_var;
 	StringName save_var;
 
+	BBHandle array_handle;
+	BBHandle save_handle;
+
 	int current_idx;
 
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual void _enter() override;
 	virtual Status _tick(double p_delta) override;
+	virtual void _save_state(const Ref<StreamPeer> &p_stream) const override;
+	virtual Error _load_state(const Ref<StreamPeer> &p_stream) override;
 
 public:
 	void set_array_var(const StringName &p_value);
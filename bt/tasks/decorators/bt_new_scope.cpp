@@ -58,6 +58,15 @@ BT::Status BTNewScope::_tick(double p_delta) {
 	return get_child(0)->execute(p_delta);
 }
 
+void BTNewScope::_save_state(const Ref<StreamPeer> &p_stream) const {
+	// Variables of the parent scopes are saved by the owner of the tree.
+	get_blackboard()->save_state(p_stream);
+}
+
+Error BTNewScope::_load_state(const Ref<StreamPeer> &p_stream) {
+	return get_blackboard()->load_state(p_stream);
+}
+
 void BTNewScope::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_blackboard_plan", "plan"), &BTNewScope::set_blackboard_plan);
 	ClassDB::bind_method(D_METHOD("get_blackboard_plan"), &BTNewScope::get_blackboard_plan);
@@ -60,6 +60,15 @@ void BTRepeat::_get_property_list(List<PropertyInfo> *p_list) const {
 	}
 }
 
+void BTRepeat::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(cur_iteration);
+}
+
+Error BTRepeat::_load_state(const Ref<StreamPeer> &p_stream) {
+	cur_iteration = p_stream->get_32();
+	return OK;
+}
+
 void BTRepeat::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_forever", "value"), &BTRepeat::set_forever);
 	ClassDB::bind_method(D_METHOD("get_forever"), &BTRepeat::get_forever);
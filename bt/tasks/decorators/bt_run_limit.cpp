@@ -39,6 +39,15 @@ BT::Status BTRunLimit::_tick(double p_delta) {
 	return child_status;
 }
 
+void BTRunLimit::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(num_runs);
+}
+
+Error BTRunLimit::_load_state(const Ref<StreamPeer> &p_stream) {
+	num_runs = p_stream->get_32();
+	return OK;
+}
+
 void BTRunLimit::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_run_limit", "max_runs"), &BTRunLimit::set_run_limit);
 	ClassDB::bind_method(D_METHOD("get_run_limit"), &BTRunLimit::get_run_limit);
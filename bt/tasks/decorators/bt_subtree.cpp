@@ -49,7 +49,8 @@ void BTSubtree::initialize(Node *p_agent, const Ref<Blackboard> &p_blackboard, N
 	ERR_FAIL_COND_MSG(!subtree->get_root_task().is_valid(), "Subtree root task is not valid.");
 	ERR_FAIL_COND_MSG(get_child_count() != 0, "Subtree task shouldn't have children during initialization.");
 
-	add_child(subtree->get_root_task()->clone());
+	const Ref<BTTask> &root = subtree->get_root_task();
+	add_child(subtree->get_share_task_config() ? root->clone_shared() : root->clone());
 
 	BTNewScope::initialize(p_agent, p_blackboard, p_scene_root);
 }
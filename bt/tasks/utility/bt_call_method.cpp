@@ -81,11 +81,30 @@ String BTCallMethod::_generate_name() {
 			result_var == StringName() ? "" : LimboUtility::get_singleton()->decorate_output_var(result_var));
 }
 
+void BTCallMethod::_setup() {
+	const Ref<Blackboard> &bb = get_blackboard();
+	if (node_param.is_valid()) {
+		node_handle = node_param->resolve_handle(bb);
+	}
+	arg_handles.resize(args.size());
+	for (int i = 0; i < args.size(); i++) {
+		Ref<BBVariant> param = args[i];
+		if (param.is_valid()) {
+			arg_handles[i] = param->resolve_handle(bb);
+		}
+	}
+	result_handle = BBHandle(result_var);
+}
+
 BT::Status BTCallMethod::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(method == StringName(), FAILURE, "BTCallMethod: Method Name is not set.");
 	ERR_FAIL_COND_V_MSG(node_param.is_null(), FAILURE, "BTCallMethod: Node parameter is not set.");
-	Object *obj = node_param->get_value(get_scene_root(), get_blackboard());
+	const Ref<Blackboard> &bb = get_blackboard();
+	Object *obj = node_param->get_value_cached(get_scene_root(), bb, node_handle, node_cache);
 	ERR_FAIL_COND_V_MSG(obj == nullptr, FAILURE, "BTCallMethod: Failed to get object: " + node_param->to_string());
+	if (unlikely(arg_handles.size() != uint32_t(args.size()))) {
+		arg_handles.resize(args.size());
+	}
 
 	Variant result;
 	Array call_args;
@@ -102,7 +121,7 @@ BT::Status BTCallMethod::_tick(double p_delta) {
 		}
 		for (int i = 0; i < args.size(); i++) {
 			Ref<BBVariant> param = args[i];
-			call_args.push_back(param->get_value(get_scene_root(), get_blackboard()));
+			call_args.push_back(param->get_value_by_handle(get_scene_root(), bb, arg_handles[i]));
 			argptrs[i + int(include_delta)] = &call_args[i];
 		}
 	}
@@ -118,7 +137,7 @@ BT::Status BTCallMethod::_tick(double p_delta) {
 	}
 	for (int i = 0; i < args.size(); i++) {
 		Ref<BBVariant> param = args[i];
-		call_args.push_back(param->get_value(get_scene_root(), get_blackboard()));
+		call_args.push_back(param->get_value_by_handle(get_scene_root(), bb, arg_handles[i]));
 	}
 
 	// TODO: Unsure how to detect call error, so we return SUCCESS for now...
@@ -126,7 +145,10 @@ BT::Status BTCallMethod::_tick(double p_delta) {
 #endif // LIMBOAI_MODULE & LIMBOAI_GDEXTENSION
 
 	if (result_var != StringName()) {
-		get_blackboard()->set_var(result_var, result);
+		if (unlikely(result_handle.name != result_var)) {
+			result_handle = BBHandle(result_var);
+		}
+		bb->set_var_by_handle(result_handle, result);
 	}
 
 	return SUCCESS;
@@ -155,4 +177,5 @@ void BTCallMethod::_bind_methods() {
 }
 
 BTCallMethod::BTCallMethod() {
+	node_cache.on_tree_exiting = callable_mp(this, &BTCallMethod::_on_node_tree_exiting);
 }
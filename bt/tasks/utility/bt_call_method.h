@@ -28,10 +28,18 @@ private:
 	bool include_delta = false;
 	StringName result_var;
 
+	BBHandle node_handle;
+	BBNodeCache node_cache;
+	LocalVector<BBHandle> arg_handles;
+	BBHandle result_handle;
+
+	void _on_node_tree_exiting() { node_cache.invalidate(); }
+
 protected:
 	static void _bind_methods();
 
 	virtual String _generate_name() override;
+	virtual void _setup() override;
 	virtual Status _tick(double p_delta) override;
 
 public:
@@ -79,6 +79,19 @@ PackedStringArray BTEvaluateExpression::get_configuration_warnings() {
 }
 
 void BTEvaluateExpression::_setup() {
+	const Ref<Blackboard> &bb = get_blackboard();
+	if (node_param.is_valid()) {
+		node_handle = node_param->resolve_handle(bb);
+	}
+	input_handles.resize(input_values.size());
+	for (int i = 0; i < input_values.size(); i++) {
+		Ref<BBVariant> param = input_values[i];
+		if (param.is_valid()) {
+			input_handles[i] = param->resolve_handle(bb);
+		}
+	}
+	result_handle = BBHandle(result_var);
+
 	parse();
 	ERR_FAIL_COND_MSG(is_parsed != Error::OK, "BTEvaluateExpression: Failed to parse expression: " + expression->get_error_text());
 }
@@ -108,23 +121,30 @@ String BTEvaluateExpression::_generate_name() {
 BT::Status BTEvaluateExpression::_tick(double p_delta) {
 	ERR_FAIL_COND_V_MSG(expression_string.is_empty(), FAILURE, "BTEvaluateExpression: Expression String is not set.");
 	ERR_FAIL_COND_V_MSG(node_param.is_null(), FAILURE, "BTEvaluateExpression: Node parameter is not set.");
-	Object *obj = node_param->get_value(get_scene_root(), get_blackboard());
+	const Ref<Blackboard> &bb = get_blackboard();
+	Object *obj = node_param->get_value_cached(get_scene_root(), bb, node_handle, node_cache);
 	ERR_FAIL_COND_V_MSG(obj == nullptr, FAILURE, "BTEvaluateExpression: Failed to get object: " + node_param->to_string());
 	ERR_FAIL_COND_V_MSG(is_parsed != Error::OK, FAILURE, "BTEvaluateExpression: Failed to parse expression: " + expression->get_error_text());
 
 	if (input_include_delta) {
 		processed_input_values[0] = p_delta;
 	}
+	if (unlikely(input_handles.size() != uint32_t(input_values.size()))) {
+		input_handles.resize(input_values.size());
+	}
 	for (int i = 0; i < input_values.size(); ++i) {
 		const Ref<BBVariant> &bb_variant = input_values[i];
-		processed_input_values[i + int(input_include_delta)] = bb_variant->get_value(get_scene_root(), get_blackboard());
+		processed_input_values[i + int(input_include_delta)] = bb_variant->get_value_by_handle(get_scene_root(), bb, input_handles[i]);
 	}
 
 	Variant result = expression->execute(processed_input_values, obj, false);
 	ERR_FAIL_COND_V_MSG(expression->has_execute_failed(), FAILURE, "BTEvaluateExpression: Failed to execute: " + expression->get_error_text());
 
 	if (result_var != StringName()) {
-		get_blackboard()->set_var(result_var, result);
+		if (unlikely(result_handle.name != result_var)) {
+			result_handle = BBHandle(result_var);
+		}
+		bb->set_var_by_handle(result_handle, result);
 	}
 
 	return SUCCESS;
@@ -158,4 +178,5 @@ void BTEvaluateExpression::_bind_methods() {
 
 BTEvaluateExpression::BTEvaluateExpression() {
 	expression.instantiate();
+	node_cache.on_tree_exiting = callable_mp(this, &BTEvaluateExpression::_on_node_tree_exiting);
 }
@@ -41,6 +41,13 @@ private:
 	Array processed_input_values;
 	StringName result_var;
 
+	BBHandle node_handle;
+	BBNodeCache node_cache;
+	LocalVector<BBHandle> input_handles;
+	BBHandle result_handle;
+
+	void _on_node_tree_exiting() { node_cache.invalidate(); }
+
 protected:
 	static void _bind_methods();
 
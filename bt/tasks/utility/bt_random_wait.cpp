@@ -47,6 +47,15 @@ void BTRandomWait::set_max_duration(double p_max_duration) {
 	emit_changed();
 }
 
+void BTRandomWait::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_double(duration);
+}
+
+Error BTRandomWait::_load_state(const Ref<StreamPeer> &p_stream) {
+	duration = p_stream->get_double();
+	return OK;
+}
+
 void BTRandomWait::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_min_duration", "duration_sec"), &BTRandomWait::set_min_duration);
 	ClassDB::bind_method(D_METHOD("get_min_duration"), &BTRandomWait::get_min_duration);
@@ -28,6 +28,15 @@ BT::Status BTWaitTicks::_tick(double p_delta) {
 	}
 }
 
+void BTWaitTicks::_save_state(const Ref<StreamPeer> &p_stream) const {
+	p_stream->put_32(num_passed);
+}
+
+Error BTWaitTicks::_load_state(const Ref<StreamPeer> &p_stream) {
+	num_passed = p_stream->get_32();
+	return OK;
+}
+
 void BTWaitTicks::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("set_num_ticks", "num_ticks"), &BTWaitTicks::set_num_ticks);
 	ClassDB::bind_method(D_METHOD("get_num_ticks"), &BTWaitTicks::get_num_ticks);
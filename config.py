@@ -92,6 +92,7 @@ def get_doc_classes():
         "BTPlayer",
         "BTProbability",
         "BTProbabilitySelector",
+        "BTProfiler",
         "BTRandomSelector",
         "BTRandomSequence",
         "BTRandomWait",
@@ -108,9 +109,12 @@ def get_doc_classes():
         "BTSubtree",
         "BTTask",
         "BTTimeLimit",
+        "BTUtilitySelector",
         "BTWait",
         "BTWaitTicks",
+        "BTWorld",
         "LimboHSM",
         "LimboState",
         "LimboUtility",
+        "SharedBlackboard",
     ]
@@ -230,6 +230,54 @@ void BehaviorTreeView::_update_tree(const Ref<BehaviorTreeData> &p_data) {
 	}
 }
 
+void BehaviorTreeView::update_profile(const Array &p_data) {
+	profile_data = p_data;
+	profile_pending = true;
+	if (tree->get_columns() < 4) {
+		tree->set_columns(4); // task | status icon | elapsed | time per tick
+		tree->set_column_expand(3, false);
+		_do_update_theme_item_cache();
+	}
+}
+
+void BehaviorTreeView::clear_profile() {
+	profile_data.clear();
+	profile_pending = false;
+	tree->set_columns(3);
+}
+
+void BehaviorTreeView::_update_profile(const Array &p_data) {
+	// Format: [updates, ticks, inclusive_usec, exclusive_usec, ...] for each task in pre-order.
+	TreeItem *item = tree->get_root();
+	int idx = 1;
+	while (item && idx + 2 < p_data.size()) {
+		const int64_t ticks = p_data[idx];
+		const double inclusive_usec = p_data[idx + 1];
+		const double exclusive_usec = p_data[idx + 2];
+		const double per_tick = ticks > 0 ? inclusive_usec / ticks : 0.0;
+
+		item->set_text_alignment(3, HORIZONTAL_ALIGNMENT_RIGHT);
+		item->set_text(3, ticks > 0 ? String::num(per_tick, 1) : String("-"));
+		item->set_tooltip_text(3, vformat(TTR("Ticks: %d\nInclusive: %.2f ms (%.1f usec per tick)\nExclusive: %.2f ms (%.1f usec per tick)"),
+				ticks, inclusive_usec * 0.001, per_tick, exclusive_usec * 0.001, ticks > 0 ? exclusive_usec / ticks : 0.0));
+
+		if (item->get_first_child()) {
+			item = item->get_first_child();
+		} else if (item->get_next()) {
+			item = item->get_next();
+		} else {
+			while (item) {
+				item = item->get_parent();
+				if (item && item->get_next()) {
+					item = item->get_next();
+					break;
+				}
+			}
+		}
+		idx += 3;
+	}
+}
+
 void BehaviorTreeView::clear() {
 	tree->clear();
 	collapsed_ids.clear();
@@ -280,6 +328,10 @@ void BehaviorTreeView::_do_update_theme_item_cache() {
 	int font_size = tree->get_theme_font_size(LW_NAME(font_size));
 	int timings_size = font->get_string_size("00.00", HORIZONTAL_ALIGNMENT_RIGHT, -1, font_size).x + 16 + extra_spacing;
 	tree->set_column_custom_minimum_width(2, timings_size * _get_editor_scale());
+	if (tree->get_columns() > 3) {
+		int profile_size = font->get_string_size("0000.0", HORIZONTAL_ALIGNMENT_RIGHT, -1, font_size).x + 16 + extra_spacing;
+		tree->set_column_custom_minimum_width(3, profile_size * _get_editor_scale());
+	}
 }
 
 void BehaviorTreeView::_notification(int p_what) {
@@ -303,6 +355,10 @@ void BehaviorTreeView::_notification(int p_what) {
 				update_pending = false;
 				last_update_msec = ticks_msec;
 			}
+			if (profile_pending && !update_pending) {
+				_update_profile(profile_data);
+				profile_pending = false;
+			}
 		} break;
 	}
 }
@@ -314,6 +370,8 @@ void BehaviorTreeView::_bind_methods() {
 	ClassDB::bind_method(D_METHOD("_item_collapsed"), &BehaviorTreeView::_item_collapsed);
 	ClassDB::bind_method(D_METHOD("update_tree", "behavior_tree_data"), &BehaviorTreeView::update_tree);
 	ClassDB::bind_method(D_METHOD("clear"), &BehaviorTreeView::clear);
+	ClassDB::bind_method(D_METHOD("update_profile", "profile_data"), &BehaviorTreeView::update_profile);
+	ClassDB::bind_method(D_METHOD("clear_profile"), &BehaviorTreeView::clear_profile);
 
 	ClassDB::bind_method(D_METHOD("set_update_interval_msec", "interval_msec"), &BehaviorTreeView::set_update_interval_msec);
 	ClassDB::bind_method(D_METHOD("get_update_interval_msec"), &BehaviorTreeView::get_update_interval_msec);
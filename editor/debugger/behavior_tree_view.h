@@ -56,6 +56,9 @@ private:
 	Ref<BehaviorTreeData> update_data;
 	bool update_pending = false;
 
+	Array profile_data;
+	bool profile_pending = false;
+
 	void _draw_success_status(Object *p_obj, Rect2 p_rect);
 	void _draw_running_status(Object *p_obj, Rect2 p_rect);
 	void _draw_failure_status(Object *p_obj, Rect2 p_rect);
@@ -65,6 +68,7 @@ private:
 	double _get_editor_scale() const;
 
 	void _update_tree(const Ref<BehaviorTreeData> &p_data);
+	void _update_profile(const Array &p_data);
 
 protected:
 	void _do_update_theme_item_cache();
@@ -76,6 +80,8 @@ protected:
 public:
 	void clear();
 	void update_tree(const Ref<BehaviorTreeData> &p_data);
+	void update_profile(const Array &p_data);
+	void clear_profile();
 
 	void set_update_interval_msec(int p_milliseconds) { update_interval_msec = p_milliseconds; }
 	int get_update_interval_msec() const { return update_interval_msec; }
@@ -12,6 +12,7 @@
 #include "limbo_debugger.h"
 
 #include "../../bt/bt_instance.h"
+#include "../../bt/bt_profiler.h"
 #include "../../bt/tasks/bt_task.h"
 #include "../../util/limbo_compat.h"
 #include "behavior_tree_data.h"
@@ -74,6 +75,9 @@ Error LimboDebugger::parse_message(void *p_user, const String &p_msg, const Arra
 		singleton->_send_active_bt_players();
 	} else if (p_msg == "stop_session") {
 		singleton->session_active = false;
+	} else if (p_msg == "set_profiling") {
+		ERR_FAIL_COND_V(p_args.size() < 1, ERR_INVALID_PARAMETER);
+		singleton->_set_profiling(p_args[0]);
 	} else {
 		r_captured = false;
 	}
@@ -179,6 +183,23 @@ void LimboDebugger::_on_bt_instance_updated(int _status, uint64_t p_instance_id)
 	ERR_FAIL_NULL(inst);
 	Array arr = BehaviorTreeData::serialize(inst);
 	EngineDebugger::get_singleton()->send_message("limboai:bt_update", arr);
+
+	if (profiling) {
+		// Aggregated over all instances of the tracked behavior tree.
+		Array profile;
+		profile.push_back(p_instance_id);
+		profile.append_array(BTProfiler::get_singleton()->serialize_tree_profile(inst->get_source_bt_path()));
+		EngineDebugger::get_singleton()->send_message("limboai:bt_profile", profile);
+	}
+}
+
+void LimboDebugger::_set_profiling(bool p_enabled) {
+	ERR_FAIL_NULL(BTProfiler::get_singleton());
+	profiling = p_enabled;
+	if (profiling) {
+		BTProfiler::get_singleton()->clear();
+	}
+	BTProfiler::get_singleton()->set_enabled(profiling);
 }
 
 #endif // ! DEBUG_ENABLED
@@ -51,10 +51,12 @@ private:
 	HashSet<uint64_t> active_bt_instances;
 	uint64_t tracked_instance_id = 0;
 	bool session_active = false;
+	bool profiling = false;
 
 	void _track_tree(uint64_t p_instance_id);
 	void _untrack_tree();
 	void _send_active_bt_players();
+	void _set_profiling(bool p_enabled);
 
 	void _on_bt_instance_updated(int status, uint64_t p_instance_id);
 
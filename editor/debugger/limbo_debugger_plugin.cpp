@@ -74,6 +74,9 @@ void LimboDebuggerTab::start_session() {
 	info_message->set_text(TTR("Pick a player from the list to display behavior tree."));
 	info_message->show();
 	session->send_message("limboai:start_session", Array());
+	if (profile_button->is_pressed()) {
+		_profile_toggled(true);
+	}
 }
 
 void LimboDebuggerTab::stop_session() {
@@ -180,6 +183,17 @@ void LimboDebuggerTab::_resource_header_pressed() {
 	EditorInterface::get_singleton()->edit_resource(bt);
 }
 
+void LimboDebuggerTab::_profile_toggled(bool p_pressed) {
+	if (!p_pressed) {
+		bt_view->clear_profile();
+	}
+	if (session.is_valid() && session->is_active()) {
+		Array msg_data;
+		msg_data.push_back(p_pressed);
+		session->send_message("limboai:set_profiling", msg_data);
+	}
+}
+
 void LimboDebuggerTab::_bind_methods() {
 }
 
@@ -187,6 +201,7 @@ void LimboDebuggerTab::_notification(int p_what) {
 	switch (p_what) {
 		case NOTIFICATION_READY: {
 			resource_header->connect(LW_NAME(pressed), callable_mp(this, &LimboDebuggerTab::_resource_header_pressed));
+			profile_button->connect(LW_NAME(toggled), callable_mp(this, &LimboDebuggerTab::_profile_toggled));
 			filter_players->connect(LW_NAME(text_changed), callable_mp(this, &LimboDebuggerTab::_filter_changed));
 			bt_instance_list->connect(LW_NAME(item_selected), callable_mp(this, &LimboDebuggerTab::_bt_instance_selected));
 			update_interval->connect("value_changed", callable_mp(bt_view, &BehaviorTreeView::set_update_interval_msec));
@@ -246,6 +261,13 @@ LimboDebuggerTab::LimboDebuggerTab() {
 	resource_header->set_tooltip_text(TTR("Debugged BehaviorTree resource.\nClick to open."));
 	resource_header->set_disabled(true);
 
+	profile_button = memnew(Button);
+	toolbar->add_child(profile_button);
+	profile_button->set_toggle_mode(true);
+	profile_button->set_focus_mode(FOCUS_NONE);
+	profile_button->set_text(TTR("Profile"));
+	profile_button->set_tooltip_text(TTR("Measure execution time of each task.\nTimings are aggregated over all instances of the debugged BehaviorTree."));
+
 	Label *interval_label = memnew(Label);
 	toolbar->add_child(interval_label);
 	interval_label->set_text(TTR("Update Interval:"));
@@ -361,6 +383,11 @@ bool LimboDebuggerPlugin::_capture(const String &p_message, const Array &p_data,
 		if (data->bt_instance_id == tab->get_selected_bt_instance_id()) {
 			tab->update_behavior_tree(data);
 		}
+	} else if (p_message == "limboai:bt_profile") {
+		ERR_FAIL_COND_V(p_data.is_empty(), true);
+		if (uint64_t(p_data[0]) == tab->get_selected_bt_instance_id()) {
+			tab->get_behavior_tree_view()->update_profile(p_data.slice(1));
+		}
 	} else {
 		captured = false;
 	}
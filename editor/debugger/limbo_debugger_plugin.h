@@ -71,6 +71,7 @@ private:
 	LineEdit *filter_players = nullptr;
 	Button *resource_header = nullptr;
 	Button *make_floating = nullptr;
+	Button *profile_button = nullptr;
 	EditorSpinSlider *update_interval = nullptr;
 	CompatWindowWrapper *window_wrapper = nullptr;
 
@@ -81,6 +82,7 @@ private:
 	void _filter_changed(String p_text);
 	void _window_visibility_changed(bool p_visible);
 	void _resource_header_pressed();
+	void _profile_toggled(bool p_pressed);
 
 protected:
 	static void _bind_methods();
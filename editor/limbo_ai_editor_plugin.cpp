@@ -16,6 +16,7 @@
 #include "../bt/behavior_tree.h"
 #include "../bt/tasks/bt_comment.h"
 #include "../bt/tasks/composites/bt_probability_selector.h"
+#include "../bt/tasks/composites/bt_utility_selector.h"
 #include "../bt/tasks/composites/bt_selector.h"
 #include "../bt/tasks/decorators/bt_subtree.h"
 #include "../util/limbo_compat.h"
@@ -553,7 +554,8 @@ void LimboAIEditor::_on_tree_rmb(const Vector2 &p_menu_pos) {
 	ERR_FAIL_COND_MSG(task.is_null(), "LimboAIEditor: get_selected() returned null");
 
 	if (task_tree->selected_has_probability()) {
-		menu->add_icon_item(theme_cache.percent_icon, TTR("Edit Probability"), ACTION_EDIT_PROBABILITY);
+		const bool is_utility = Ref<BTUtilitySelector>(task->get_parent()).is_valid();
+		menu->add_icon_item(theme_cache.percent_icon, is_utility ? TTR("Edit Weight") : TTR("Edit Probability"), ACTION_EDIT_PROBABILITY);
 	}
 	menu->add_icon_shortcut(theme_cache.rename_task_icon, LW_GET_SHORTCUT("limbo_ai/rename_task"), ACTION_RENAME);
 	menu->add_icon_item(theme_cache.change_type_icon, TTR("Change Type"), ACTION_CHANGE_TYPE);
@@ -747,6 +749,11 @@ void LimboAIEditor::_action_selected(int p_id) {
 void LimboAIEditor::_on_probability_edited(double p_value) {
 	Ref<BTTask> selected = task_tree->get_selected();
 	ERR_FAIL_COND(selected == nullptr);
+	Ref<BTUtilitySelector> utility_selector = selected->get_parent();
+	if (utility_selector.is_valid()) {
+		utility_selector->set_weight(selected->get_index(), p_value);
+		return;
+	}
 	Ref<BTProbabilitySelector> probability_selector = selected->get_parent();
 	ERR_FAIL_COND(probability_selector.is_null());
 	if (percent_mode->is_pressed()) {
@@ -759,10 +766,15 @@ void LimboAIEditor::_on_probability_edited(double p_value) {
 void LimboAIEditor::_update_probability_edit() {
 	Ref<BTTask> selected = task_tree->get_selected();
 	ERR_FAIL_COND(selected.is_null());
+	bool cannot_edit_percent = true; // Weights of a utility selector don't translate to probabilities.
 	Ref<BTProbabilitySelector> prob = selected->get_parent();
-	ERR_FAIL_COND(prob.is_null());
-	double others_weight = prob->get_total_weight() - prob->get_weight(selected->get_index());
-	bool cannot_edit_percent = others_weight == 0.0;
+	if (prob.is_valid()) {
+		double others_weight = prob->get_total_weight() - prob->get_weight(selected->get_index());
+		cannot_edit_percent = others_weight == 0.0;
+	} else {
+		Ref<BTUtilitySelector> utility_selector = selected->get_parent();
+		ERR_FAIL_COND(utility_selector.is_null());
+	}
 	percent_mode->set_disabled(cannot_edit_percent);
 	if (cannot_edit_percent && percent_mode->is_pressed()) {
 		weight_mode->set_pressed(true);
@@ -1090,9 +1102,16 @@ void LimboAIEditor::_replace_task(const Ref<BTTask> &p_task, const Ref<BTTask> &
 		int idx = p_task->get_index();
 
 		double weight = 0.0;
+		StringName utility_var;
+		Ref<Curve> utility_curve;
 		Ref<BTProbabilitySelector> probability_selector = parent;
+		Ref<BTUtilitySelector> utility_selector = parent;
 		if (probability_selector.is_valid()) {
 			weight = probability_selector->get_weight(idx);
+		} else if (utility_selector.is_valid()) {
+			weight = utility_selector->get_weight(idx);
+			utility_var = utility_selector->get_consideration_var(idx);
+			utility_curve = utility_selector->get_consideration_curve(idx);
 		}
 
 		parent->remove_child(p_task);
@@ -1100,6 +1119,9 @@ void LimboAIEditor::_replace_task(const Ref<BTTask> &p_task, const Ref<BTTask> &
 
 		if (probability_selector.is_valid()) {
 			probability_selector->set_weight(idx, weight);
+		} else if (utility_selector.is_valid()) {
+			utility_selector->set_weight(idx, weight);
+			utility_selector->set_consideration(idx, utility_var, utility_curve);
 		}
 	}
 }
@@ -15,6 +15,7 @@
 
 #include "../bt/tasks/bt_comment.h"
 #include "../bt/tasks/composites/bt_probability_selector.h"
+#include "../bt/tasks/composites/bt_utility_selector.h"
 #include "../util/limbo_compat.h"
 #include "../util/limbo_utility.h"
 #include "tree_search.h"
@@ -63,7 +64,9 @@ void TaskTree::_update_item(TreeItem *p_item) {
 
 	if (p_item->get_parent()) {
 		Ref<BTProbabilitySelector> sel = p_item->get_parent()->get_metadata(0);
-		if (sel.is_valid() && sel->has_probability(p_item->get_index())) {
+		Ref<BTUtilitySelector> utility_sel = p_item->get_parent()->get_metadata(0);
+		if ((sel.is_valid() && sel->has_probability(p_item->get_index())) ||
+				(utility_sel.is_valid() && utility_sel->has_weight(p_item->get_index()))) {
 			p_item->set_custom_draw_callback(0, callable_mp(this, &TaskTree::_draw_probability));
 			p_item->set_cell_mode(0, TreeItem::CELL_MODE_CUSTOM);
 		}
@@ -293,6 +296,10 @@ Rect2 TaskTree::get_selected_probability_rect() const {
 double TaskTree::get_selected_probability_weight() const {
 	Ref<BTTask> selected = get_selected();
 	ERR_FAIL_COND_V(selected.is_null(), 0.0);
+	Ref<BTUtilitySelector> utility_selector = selected->get_parent();
+	if (utility_selector.is_valid()) {
+		return utility_selector->get_weight(selected->get_index());
+	}
 	Ref<BTProbabilitySelector> probability_selector = selected->get_parent();
 	ERR_FAIL_COND_V(probability_selector.is_null(), 0.0);
 	return probability_selector->get_weight(selected->get_index());
@@ -311,7 +318,8 @@ bool TaskTree::selected_has_probability() const {
 	Ref<BTTask> selected = get_selected();
 	if (selected.is_valid() && !IS_CLASS(selected, BTComment)) {
 		Ref<BTProbabilitySelector> probability_selector = selected->get_parent();
-		result = probability_selector.is_valid();
+		Ref<BTUtilitySelector> utility_selector = selected->get_parent();
+		result = probability_selector.is_valid() || utility_selector.is_valid();
 	}
 	return result;
 }
@@ -484,12 +492,18 @@ void TaskTree::_draw_probability(Object *item_obj, Rect2 rect) {
 	if (!item) {
 		return;
 	}
+	String text;
 	Ref<BTProbabilitySelector> sel = item->get_parent()->get_metadata(0);
-	if (sel.is_null()) {
+	Ref<BTUtilitySelector> utility_sel = item->get_parent()->get_metadata(0);
+	if (sel.is_valid()) {
+		text = rtos(Math::snapped(sel->get_probability(item->get_index()) * 100, 0.01)) + "%";
+	} else if (utility_sel.is_valid()) {
+		// Utility selectors have no probabilities: display the score weight.
+		text = String::utf8("×") + rtos(Math::snapped(utility_sel->get_weight(item->get_index()), 0.01));
+	} else {
 		return;
 	}
 
-	String text = rtos(Math::snapped(sel->get_probability(item->get_index()) * 100, 0.01)) + "%";
 	Size2 text_size = theme_cache.probability_font->get_string_size(text, HORIZONTAL_ALIGNMENT_LEFT, -1, theme_cache.probability_font_size);
 
 	Rect2 prob_rect = rect;
@@ -48,9 +48,13 @@
 #include "blackboard/bb_param/bb_vector4i.h"
 #include "blackboard/blackboard.h"
 #include "blackboard/blackboard_plan.h"
+#include "blackboard/shared_blackboard.h"
 #include "bt/behavior_tree.h"
+#include "bt/bt_monitor.h"
 #include "bt/bt_player.h"
+#include "bt/bt_profiler.h"
 #include "bt/bt_state.h"
+#include "bt/bt_world.h"
 #include "bt/tasks/blackboard/bt_check_trigger.h"
 #include "bt/tasks/blackboard/bt_check_var.h"
 #include "bt/tasks/blackboard/bt_set_var.h"
@@ -68,6 +72,7 @@
 #include "bt/tasks/composites/bt_random_sequence.h"
 #include "bt/tasks/composites/bt_selector.h"
 #include "bt/tasks/composites/bt_sequence.h"
+#include "bt/tasks/composites/bt_utility_selector.h"
 #include "bt/tasks/decorators/bt_always_fail.h"
 #include "bt/tasks/decorators/bt_always_succeed.h"
 #include "bt/tasks/decorators/bt_cooldown.h"
@@ -128,6 +133,7 @@ using namespace godot;
 #endif // LIMBOAI_GDEXTENSION
 
 static LimboUtility *_limbo_utility = nullptr;
+static BTProfiler *_bt_profiler = nullptr;
 
 void initialize_limboai_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
@@ -139,10 +145,12 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		GDREGISTER_CLASS(LimboDebugger);
 #endif
 		LimboDebugger::initialize();
+		BTMonitor::initialize();
 
 		GDREGISTER_CLASS(LimboUtility);
 		GDREGISTER_CLASS(Blackboard);
 		GDREGISTER_CLASS(BlackboardPlan);
+		GDREGISTER_CLASS(SharedBlackboard);
 
 		GDREGISTER_CLASS(LimboState);
 		GDREGISTER_CLASS(LimboHSM);
@@ -153,34 +161,37 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		GDREGISTER_CLASS(BTInstance);
 		GDREGISTER_CLASS(BTPlayer);
 		GDREGISTER_CLASS(BTState);
+		GDREGISTER_CLASS(BTWorld);
+		GDREGISTER_CLASS(BTProfiler);
 
 		LIMBO_REGISTER_TASK(BTComment);
 
 		GDREGISTER_CLASS(BTComposite);
-		LIMBO_REGISTER_TASK(BTSequence);
-		LIMBO_REGISTER_TASK(BTSelector);
-		LIMBO_REGISTER_TASK(BTParallel);
-		LIMBO_REGISTER_TASK(BTDynamicSequence);
-		LIMBO_REGISTER_TASK(BTDynamicSelector);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTSequence);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTSelector);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTParallel);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTDynamicSequence);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTDynamicSelector);
 		LIMBO_REGISTER_TASK(BTProbabilitySelector);
 		LIMBO_REGISTER_TASK(BTRandomSequence);
 		LIMBO_REGISTER_TASK(BTRandomSelector);
+		LIMBO_REGISTER_TASK(BTUtilitySelector);
 
 		GDREGISTER_CLASS(BTDecorator);
-		LIMBO_REGISTER_TASK(BTInvert);
-		LIMBO_REGISTER_TASK(BTAlwaysFail);
-		LIMBO_REGISTER_TASK(BTAlwaysSucceed);
-		LIMBO_REGISTER_TASK(BTDelay);
-		LIMBO_REGISTER_TASK(BTRepeat);
-		LIMBO_REGISTER_TASK(BTRepeatUntilFailure);
-		LIMBO_REGISTER_TASK(BTRepeatUntilSuccess);
-		LIMBO_REGISTER_TASK(BTRunLimit);
-		LIMBO_REGISTER_TASK(BTTimeLimit);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTInvert);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTAlwaysFail);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTAlwaysSucceed);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTDelay);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTRepeat);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTRepeatUntilFailure);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTRepeatUntilSuccess);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTRunLimit);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTTimeLimit);
 		LIMBO_REGISTER_TASK(BTCooldown);
 		LIMBO_REGISTER_TASK(BTProbability);
-		LIMBO_REGISTER_TASK(BTForEach);
-		LIMBO_REGISTER_TASK(BTNewScope);
-		LIMBO_REGISTER_TASK(BTSubtree);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTForEach);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTNewScope);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTSubtree);
 
 		GDREGISTER_CLASS(BTAction);
 		GDREGISTER_CLASS(BTCondition);
@@ -188,18 +199,18 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		LIMBO_REGISTER_TASK(BTCallMethod);
 		LIMBO_REGISTER_TASK(BTEvaluateExpression);
 		LIMBO_REGISTER_TASK(BTConsolePrint);
-		LIMBO_REGISTER_TASK(BTFail);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTFail);
 		LIMBO_REGISTER_TASK(BTPauseAnimation);
 		LIMBO_REGISTER_TASK(BTPlayAnimation);
 		LIMBO_REGISTER_TASK(BTRandomWait);
 		LIMBO_REGISTER_TASK(BTSetAgentProperty);
-		LIMBO_REGISTER_TASK(BTSetVar);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTSetVar);
 		LIMBO_REGISTER_TASK(BTStopAnimation);
-		LIMBO_REGISTER_TASK(BTWait);
-		LIMBO_REGISTER_TASK(BTWaitTicks);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTWait);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTWaitTicks);
 		LIMBO_REGISTER_TASK(BTCheckAgentProperty);
-		LIMBO_REGISTER_TASK(BTCheckTrigger);
-		LIMBO_REGISTER_TASK(BTCheckVar);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTCheckTrigger);
+		LIMBO_REGISTER_THREAD_SAFE_TASK(BTCheckVar);
 
 		GDREGISTER_ABSTRACT_CLASS(BBParam);
 		GDREGISTER_CLASS(BBAabb);
@@ -245,6 +256,14 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 		Engine::get_singleton()->register_singleton("LimboUtility", LimboUtility::get_singleton());
 #endif
 
+		_bt_profiler = memnew(BTProfiler);
+
+#ifdef LIMBOAI_MODULE
+		Engine::get_singleton()->add_singleton(Engine::Singleton("BTProfiler", BTProfiler::get_singleton()));
+#elif LIMBOAI_GDEXTENSION
+		Engine::get_singleton()->register_singleton("BTProfiler", BTProfiler::get_singleton());
+#endif
+
 		LimboStringNames::create();
 	}
 
@@ -284,8 +303,13 @@ void initialize_limboai_module(ModuleInitializationLevel p_level) {
 void uninitialize_limboai_module(ModuleInitializationLevel p_level) {
 	if (p_level == MODULE_INITIALIZATION_LEVEL_SCENE) {
 		LimboDebugger::deinitialize();
+		BTMonitor::deinitialize();
+		SharedBlackboard::clear_scopes();
+		BlackboardPlan::clear_pending_prefetch();
+		BTTask::clear_script_cache();
 		LimboStringNames::free();
 		memdelete(_limbo_utility);
+		memdelete(_bt_profiler);
 	}
 }
 
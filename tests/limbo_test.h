@@ -18,6 +18,7 @@
 #include "tests/test_macros.h"
 
 #include "modules/limboai/bt/tasks/bt_action.h"
+#include "modules/limboai/bt/tasks/bt_condition.h"
 
 class CallbackCounter : public RefCounted {
 	GDCLASS(CallbackCounter, RefCounted);
@@ -43,6 +44,7 @@ public:
 	int num_entries = 0;
 	int num_ticks = 0;
 	int num_exits = 0;
+	StringName read_var; // If set, the variable is read from the blackboard on each tick.
 
 protected:
 	virtual void _enter() override { num_entries += 1; }
@@ -50,6 +52,9 @@ protected:
 
 	virtual Status _tick(double p_delta) override {
 		num_ticks += 1;
+		if (read_var != StringName()) {
+			get_blackboard()->get_var(read_var, Variant(), false);
+		}
 		return ret_status;
 	}
 
@@ -60,6 +65,24 @@ public:
 	BTTestAction() {}
 };
 
+class BTTestCondition : public BTCondition {
+	GDCLASS(BTTestCondition, BTCondition);
+
+public:
+	Status ret_status = BTTask::SUCCESS;
+	int num_ticks = 0;
+
+protected:
+	virtual Status _tick(double p_delta) override {
+		num_ticks += 1;
+		return ret_status;
+	}
+
+public:
+	BTTestCondition(Status p_return_status) { ret_status = p_return_status; }
+	BTTestCondition() {}
+};
+
 #define CHECK_ENTRIES_TICKS_EXITS(m_task, m_entries, m_ticks, m_exits) \
 	CHECK(m_task->num_entries == m_entries);                           \
 	CHECK(m_task->num_ticks == m_ticks);                               \
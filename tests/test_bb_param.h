@@ -69,6 +69,29 @@ TEST_CASE("[Modules][LimboAI] BBParam") {
 			CHECK(param->get_value(dummy, bb, "default_value") == Variant("default_value"));
 			ERR_PRINT_ON;
 		}
+		SUBCASE("With a resolved handle") {
+			Ref<Blackboard> parent = memnew(Blackboard);
+			parent->set_var("test_var", 123);
+			bb->set_parent(parent);
+			BBHandle handle = param->resolve_handle(bb);
+			CHECK(handle.is_resolved());
+			CHECK(param->get_value_by_handle(dummy, bb, handle) == Variant(123));
+
+			// * Re-resolved when the variable is shadowed by a local one.
+			bb->set_var("test_var", 456);
+			CHECK(param->get_value_by_handle(dummy, bb, handle) == Variant(456));
+
+			// * Re-resolved when the parameter is changed.
+			parent->set_var("other_var", 789);
+			param->set_variable("other_var");
+			CHECK(param->get_value_by_handle(dummy, bb, handle) == Variant(789));
+		}
+	}
+	SUBCASE("Test resolving handle normalizes saved value") {
+		Ref<BBInt> int_param = memnew(BBInt);
+		int_param->set_value_source(BBParam::SAVED_VALUE);
+		CHECK_FALSE(int_param->resolve_handle(bb).is_resolved());
+		CHECK_EQ(int_param->get_saved_value(), Variant(0));
 	}
 
 	memdelete(dummy);
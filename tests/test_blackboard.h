@@ -1,10 +1,15 @@
 #ifndef TEST_BLACKBOARD_H
 #define TEST_BLACKBOARD_H
 
+#include "core/io/stream_peer.h"
 #include "core/variant/variant.h"
 #include "limbo_test.h"
+#include "scene/main/node.h"
+#include "scene/main/window.h"
 
 #include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/blackboard/blackboard_plan.h"
+#include "modules/limboai/blackboard/shared_blackboard.h"
 
 namespace TestBlackboard {
 
@@ -25,6 +30,21 @@ public:
 	}
 };
 
+class TestWatcher : public RefCounted {
+	GDCLASS(TestWatcher, RefCounted);
+
+public:
+	int num_calls = 0;
+	StringName last_name;
+	Variant last_value;
+
+	void on_changed(const StringName &p_name, const Variant &p_value) {
+		num_calls += 1;
+		last_name = p_name;
+		last_value = p_value;
+	}
+};
+
 TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 	Ref<Blackboard> blackboard = memnew(Blackboard);
 
@@ -160,6 +180,22 @@ TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 		CHECK_EQ(blackboard->get_var("a", not_found), Variant(7));
 	}
 
+	SUBCASE("Test binding to freed object") {
+		TestPropertyHolder *holder = memnew(TestPropertyHolder);
+		Ref<TestPropertyHolder> holder_ref = holder;
+		blackboard->bind_var_to_property("a", holder, "property");
+		blackboard->set_var("a", Variant(8));
+		CHECK_EQ(holder->get_property(), 8);
+
+		holder_ref.unref();
+		// Falls back to the last assigned value.
+		ERR_PRINT_OFF;
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(8));
+		blackboard->set_var("a", Variant(9));
+		CHECK_EQ(blackboard->get_var("a", not_found), Variant(9));
+		ERR_PRINT_ON;
+	}
+
 	SUBCASE("Test linking") {
 		Ref<Blackboard> target_blackboard = memnew(Blackboard);
 
@@ -179,6 +215,497 @@ TEST_CASE("[Modules][LimboAI] Test Blackboard") {
 		CHECK_EQ(blackboard->get_var("a", not_found), Variant(333));
 		CHECK_EQ(target_blackboard->get_var("aa", not_found), Variant(333));
 	}
+
+	SUBCASE("Test handles") {
+		BBHandle handle = blackboard->resolve_var("b");
+		REQUIRE(handle.is_resolved());
+		CHECK(blackboard->is_handle_valid(handle));
+		CHECK_EQ(blackboard->get_var_by_handle(handle, not_found), Variant(Vector2(2, 2)));
+
+		blackboard->set_var_by_handle(handle, Vector2(3, 3));
+		CHECK_EQ(blackboard->get_var("b", not_found), Variant(Vector2(3, 3)));
+
+		// * Handle should not be valid for other blackboards.
+		Ref<Blackboard> other = memnew(Blackboard);
+		other->set_var("b", 5);
+		CHECK_FALSE(other->is_handle_valid(handle));
+
+		// * Layout changes invalidate handles, which are then re-resolved on access.
+		blackboard->erase_var("a");
+		CHECK_FALSE(blackboard->is_handle_valid(handle));
+		CHECK_EQ(blackboard->get_var_by_handle(handle, not_found), Variant(Vector2(3, 3)));
+		CHECK(blackboard->is_handle_valid(handle));
+
+		blackboard->set_var("new_var", 7); // * reuses the slot of "a"
+		CHECK_FALSE(blackboard->is_handle_valid(handle));
+		CHECK_EQ(blackboard->get_var_by_handle(handle, not_found), Variant(Vector2(3, 3)));
+		CHECK_EQ(blackboard->get_var("new_var", not_found), Variant(7));
+
+		// * Resolving through parent scopes.
+		Ref<Blackboard> parent_scope = memnew(Blackboard);
+		parent_scope->set_var("d", 123);
+		blackboard->set_parent(parent_scope);
+		CHECK_FALSE(blackboard->is_handle_valid(handle));
+		BBHandle parent_handle = blackboard->resolve_var("d");
+		REQUIRE(parent_handle.is_resolved());
+		CHECK_EQ(parent_handle.target, parent_scope);
+		CHECK_EQ(blackboard->get_var_by_handle(parent_handle, not_found), Variant(123));
+
+		// * Setting by handle creates a local variable, just like set_var().
+		blackboard->set_var_by_handle(parent_handle, 456);
+		CHECK(blackboard->has_local_var("d"));
+		CHECK_EQ(parent_handle.target, blackboard);
+		CHECK(blackboard->is_handle_valid(parent_handle));
+		CHECK_EQ(blackboard->get_var_by_handle(parent_handle, not_found), Variant(456));
+
+		// * Layout changes of unrelated blackboards don't invalidate handles.
+		other->set_var("c", 1);
+		CHECK(blackboard->is_handle_valid(parent_handle));
+		CHECK_EQ(parent_scope->get_var("d", not_found), Variant(123));
+
+		// * Unresolved handles fall back to regular lookup.
+		BBHandle missing = blackboard->resolve_var("missing");
+		CHECK_FALSE(missing.is_resolved());
+		CHECK_EQ(blackboard->get_var_by_handle(missing, not_found, false), not_found);
+		parent_scope->set_var("missing", 1);
+		CHECK_EQ(blackboard->get_var_by_handle(missing, not_found, false), Variant(1));
+
+		// * Variables added in intermediate scopes shadow the target.
+		Ref<Blackboard> top_scope = memnew(Blackboard);
+		top_scope->set_var("e", 1);
+		parent_scope->set_parent(top_scope);
+		BBHandle top_handle = blackboard->resolve_var("e");
+		REQUIRE(top_handle.is_resolved());
+		CHECK_EQ(top_handle.target, top_scope);
+		CHECK(blackboard->is_handle_valid(top_handle));
+		parent_scope->set_var("e", 2);
+		CHECK_FALSE(blackboard->is_handle_valid(top_handle));
+		CHECK_EQ(blackboard->get_var_by_handle(top_handle, not_found), Variant(2));
+		CHECK_EQ(top_handle.target, parent_scope);
+		blackboard->set_var_by_handle(top_handle, 3);
+		CHECK_EQ(blackboard->get_var("e", not_found), Variant(3));
+		CHECK_EQ(parent_scope->get_var("e", not_found), Variant(2));
+		CHECK_EQ(top_scope->get_var("e", not_found), Variant(1));
+	}
+
+	SUBCASE("Test scalar storage") {
+		Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+		plan->set_prefetch_nodepath_vars(false);
+		BBVariable speed(Variant::FLOAT);
+		speed.set_value(2.5);
+		plan->add_var("speed", speed);
+		plan->add_var("dir", BBVariable(Variant::VECTOR2));
+		plan->add_var("label", BBVariable(Variant::STRING));
+
+		Ref<Blackboard> bb = memnew(Blackboard);
+		plan->populate_blackboard(bb, true, nullptr);
+		CHECK_EQ(bb->get_var("speed", not_found), Variant(2.5));
+		CHECK_EQ(bb->get_var("dir", not_found), Variant(Vector2()));
+		CHECK(bb->is_isolated());
+
+		// * Typed access.
+		BBHandle speed_handle = bb->resolve_var("speed");
+		double speed_value = 0.0;
+		REQUIRE(bb->get_scalar_by_handle(speed_handle, speed_value));
+		CHECK_EQ(speed_value, 2.5);
+		CHECK(bb->set_scalar_by_handle(speed_handle, 4.0));
+		CHECK_EQ(bb->get_var("speed", not_found), Variant(4.0));
+		int64_t wrong_type = 0;
+		CHECK_FALSE(bb->get_scalar_by_handle(speed_handle, wrong_type));
+		BBHandle label_handle = bb->resolve_var("label");
+		CHECK_FALSE(bb->set_scalar_by_handle(label_handle, 1.0));
+
+		// * Values are per blackboard, and the plan is not modified.
+		Ref<Blackboard> other = memnew(Blackboard);
+		plan->populate_blackboard(other, true, nullptr);
+		CHECK_EQ(other->get_var("speed", not_found), Variant(2.5));
+		CHECK_EQ(plan->get_var("speed").get_value(), Variant(2.5));
+
+		// * Assigning a value of another type converts the variable to regular storage.
+		bb->set_var("speed", String("fast"));
+		CHECK_EQ(bb->get_var("speed", not_found), Variant("fast"));
+		CHECK_FALSE(bb->get_scalar_by_handle(speed_handle, speed_value));
+		CHECK_EQ(plan->get_var("speed").get_value(), Variant(2.5));
+
+		// * Linking to a scalar shares its value.
+		blackboard->link_var("a", other, "speed");
+		blackboard->set_var("a", 8.0);
+		CHECK_EQ(other->get_var("speed", not_found), Variant(8.0));
+		CHECK_EQ(plan->get_var("speed").get_value(), Variant(2.5));
+	}
+
+	SUBCASE("Test copy-on-write population") {
+		Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+		plan->set_prefetch_nodepath_vars(false);
+		BBVariable name(Variant::STRING);
+		name.set_value("plan");
+		plan->add_var("name", name);
+		BBVariable list(Variant::ARRAY);
+		Array default_list;
+		default_list.push_back(1);
+		list.set_value(default_list);
+		plan->add_var("list", list);
+
+		Ref<Blackboard> bb1 = memnew(Blackboard);
+		Ref<Blackboard> bb2 = memnew(Blackboard);
+		plan->populate_blackboard(bb1, true, nullptr);
+		plan->populate_blackboard(bb2, true, nullptr);
+		CHECK(bb1->is_isolated());
+
+		// * Writes are local to the blackboard.
+		bb1->set_var("name", String("bb1"));
+		CHECK_EQ(bb1->get_var("name", not_found), Variant("bb1"));
+		CHECK_EQ(bb2->get_var("name", not_found), Variant("plan"));
+		CHECK_EQ(plan->get_var("name").get_value(), Variant("plan"));
+
+		// * Arrays can be modified in place, which must not affect the plan or other blackboards.
+		Array bb1_list = bb1->get_var("list", not_found);
+		bb1_list.push_back(2);
+		CHECK_EQ(Array(bb1->get_var("list", not_found)).size(), 2);
+		CHECK_EQ(Array(bb2->get_var("list", not_found)).size(), 1);
+		CHECK_EQ(Array(plan->get_var("list").get_value()).size(), 1);
+
+		// * Changes to the plan apply to blackboards populated afterwards.
+		plan->get_var("name").set_value("changed");
+		Ref<Blackboard> bb3 = memnew(Blackboard);
+		plan->populate_blackboard(bb3, true, nullptr);
+		CHECK_EQ(bb3->get_var("name", not_found), Variant("changed"));
+		CHECK_EQ(bb2->get_var("name", not_found), Variant("plan"));
+	}
+
+	SUBCASE("Test var versions") {
+		const uint32_t version = blackboard->get_var_version("a");
+		const uint32_t version_b = blackboard->get_var_version("b");
+		CHECK(version > 0);
+		blackboard->set_var("a", 2);
+		CHECK_EQ(blackboard->get_var_version("a"), version + 1);
+		CHECK_EQ(blackboard->get_var_version("b"), version_b); // Versions are tracked per variable.
+		CHECK_EQ(blackboard->get_var_version("missing"), 0);
+
+		BBHandle handle = blackboard->resolve_var("a");
+		blackboard->set_var_by_handle(handle, 3);
+		CHECK_EQ(blackboard->get_var_version_by_handle(handle), version + 2);
+	}
+
+	SUBCASE("Test watchers") {
+		Ref<TestWatcher> watcher = memnew(TestWatcher);
+		Callable callable = callable_mp(watcher.ptr(), &TestWatcher::on_changed);
+		blackboard->watch_var("a", callable);
+
+		// * Multiple changes are coalesced.
+		blackboard->set_var("a", 10);
+		blackboard->set_var("a", 11);
+		blackboard->set_var("b", Vector2());
+		CHECK_EQ(watcher->num_calls, 0);
+		blackboard->flush_watchers();
+		CHECK_EQ(watcher->num_calls, 1);
+		CHECK_EQ(watcher->last_name, StringName("a"));
+		CHECK_EQ(watcher->last_value, Variant(11));
+
+		blackboard->flush_watchers();
+		CHECK_EQ(watcher->num_calls, 1);
+
+		// * Variables can be watched before they exist.
+		blackboard->watch_var("new_var", callable);
+		blackboard->set_var("new_var", true);
+		blackboard->flush_watchers();
+		CHECK_EQ(watcher->num_calls, 2);
+		CHECK_EQ(watcher->last_name, StringName("new_var"));
+
+		blackboard->unwatch_var("a", callable);
+		blackboard->set_var("a", 12);
+		blackboard->flush_watchers();
+		CHECK_EQ(watcher->num_calls, 2);
+	}
+
+	SUBCASE("Test shared scope") {
+		Ref<SharedBlackboard> world = SharedBlackboard::get_scope("test_world");
+		CHECK_EQ(SharedBlackboard::get_scope("test_world"), world);
+		world->set_var("alarm", false);
+		CHECK_EQ(world->get_var("alarm", not_found), Variant(false));
+
+		// * Nested scopes only see published values.
+		blackboard->set_parent(world);
+		CHECK_FALSE(blackboard->has_var("alarm"));
+		world->publish();
+		CHECK(blackboard->has_var("alarm"));
+		CHECK_EQ(blackboard->get_var("alarm", not_found), Variant(false));
+
+		world->set_var("alarm", true);
+		CHECK_EQ(blackboard->get_var("alarm", not_found), Variant(false));
+		SharedBlackboard::publish_pending();
+		CHECK_EQ(blackboard->get_var("alarm", not_found), Variant(true));
+		CHECK_EQ(blackboard->get_var_version("alarm"), world->get_var_version("alarm"));
+
+		// * Shared scopes don't prevent threaded updates.
+		CHECK(blackboard->is_isolated());
+
+		// * Published containers can't be modified by readers.
+		Array inner;
+		inner.push_back(2);
+		Array list;
+		list.push_back(1);
+		list.push_back(inner);
+		world->set_var("list", list);
+		world->publish();
+		Array published = blackboard->get_var("list", not_found);
+		CHECK(published.is_read_only());
+		CHECK(Array(published[1]).is_read_only());
+		ERR_PRINT_OFF;
+		published.push_back(3);
+		Array(published[1]).push_back(3);
+		ERR_PRINT_ON;
+		published = blackboard->get_var("list", not_found);
+		CHECK_EQ(published.size(), 2);
+		CHECK_EQ(Array(published[1]).size(), 1);
+		CHECK_FALSE(list.is_read_only());
+
+		// * Unchanged variables are reused by the next snapshot, without copying.
+		world->set_var("alarm", false);
+		world->publish();
+		Array republished = blackboard->get_var("list", not_found);
+		CHECK_EQ(republished.id(), published.id());
+		CHECK_EQ(blackboard->get_var("alarm", not_found), Variant(false));
+
+		// * Pinned snapshots outlive later publishes.
+		{
+			const SharedBlackboard::ReadLock lock(world.ptr());
+			const SharedBlackboard::SnapshotVar *pinned = lock.get_var("alarm");
+			REQUIRE(pinned != nullptr);
+			world->set_var("alarm", true);
+			world->publish();
+			world->set_var("alarm", false);
+			world->publish();
+			CHECK_EQ(pinned->value, Variant(false));
+			CHECK_EQ(lock.get_snapshot()->vars.size(), 2);
+		}
+		world->set_var("alarm", true);
+		world->publish();
+		CHECK_EQ(blackboard->get_var("alarm", not_found), Variant(true));
+
+		// * Attached by plan.
+		Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+		plan->set_prefetch_nodepath_vars(false);
+		plan->set_shared_scope("test_world");
+		Ref<Blackboard> agent_bb = plan->create_blackboard(nullptr);
+		CHECK_EQ(agent_bb->get_parent(), world);
+		CHECK_EQ(agent_bb->get_var("alarm", not_found), Variant(true));
+
+		// * Handles read the published snapshot directly.
+		BBHandle alarm_handle = blackboard->resolve_var("alarm");
+		REQUIRE(alarm_handle.is_resolved());
+		CHECK(alarm_handle.published);
+		CHECK(alarm_handle.target.ptr() == world.ptr());
+		CHECK(blackboard->is_handle_valid(alarm_handle));
+		CHECK_EQ(blackboard->get_var_by_handle(alarm_handle, not_found), Variant(true));
+		world->set_var("alarm", false);
+		world->publish();
+		CHECK(blackboard->is_handle_valid(alarm_handle)); // * Assigning values doesn't change the layout.
+		CHECK_EQ(blackboard->get_var_by_handle(alarm_handle, not_found), Variant(false));
+		CHECK_EQ(blackboard->get_var_version_by_handle(alarm_handle), world->get_var_version("alarm"));
+
+		world->set_var("level", 0.5);
+		CHECK(blackboard->is_handle_valid(alarm_handle)); // * Unpublished changes are not visible.
+		world->publish();
+		CHECK_FALSE(blackboard->is_handle_valid(alarm_handle));
+		CHECK_EQ(blackboard->get_var_by_handle(alarm_handle, not_found), Variant(false));
+		CHECK(blackboard->is_handle_valid(alarm_handle));
+
+		BBHandle level_handle("level");
+		double level = 0.0;
+		blackboard->get_scalars_by_handles(&level_handle, &level, 1);
+		CHECK_EQ(level, 0.5);
+		CHECK(level_handle.published);
+
+		// * Local variables shadow the shared ones.
+		blackboard->set_var("alarm", 1);
+		CHECK_FALSE(blackboard->is_handle_valid(alarm_handle));
+		CHECK_EQ(blackboard->get_var_by_handle(alarm_handle, not_found), Variant(1));
+		CHECK_FALSE(alarm_handle.published);
+
+		blackboard->set_parent(Ref<Blackboard>());
+		SharedBlackboard::remove_scope("test_world");
+		CHECK_FALSE(SharedBlackboard::has_scope("test_world"));
+	}
+
+	SUBCASE("Test state serialization") {
+		Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+		plan->set_prefetch_nodepath_vars(false);
+		plan->add_var("speed", BBVariable(Variant::FLOAT));
+		plan->add_var("dir", BBVariable(Variant::VECTOR2));
+		Ref<Blackboard> parent = memnew(Blackboard);
+		parent->set_var("p", 1);
+		Ref<Blackboard> bb = plan->create_blackboard(nullptr, parent);
+		bb->set_var("speed", 3.5);
+		bb->set_var("dir", Vector2(1, -1));
+		bb->set_var("flag", true);
+		bb->set_var("count", 42);
+		bb->set_var("label", "text");
+		bb->set_var("target", parent);
+
+		Ref<StreamPeerBuffer> buffer = memnew(StreamPeerBuffer);
+		ERR_PRINT_OFF;
+		bb->save_state(buffer, true); // "target" can't be saved.
+		ERR_PRINT_ON;
+
+		bb->set_var("speed", 0.0);
+		bb->set_var("dir", Vector2());
+		bb->set_var("count", 0);
+		bb->set_var("label", "changed");
+		bb->set_var("target", Variant());
+		bb->erase_var("flag");
+		bb->set_var("extra", 1);
+		parent->set_var("p", 2);
+
+		buffer->seek(0);
+		CHECK_EQ(bb->load_state(buffer), OK);
+		CHECK_EQ(buffer->get_available_bytes(), 0);
+		CHECK_FALSE(bb->has_var("extra")); // Variables missing from the state are erased.
+		CHECK_EQ(bb->get_var("speed", not_found), Variant(3.5));
+		CHECK_EQ(bb->get_var("dir", not_found), Variant(Vector2(1, -1)));
+		CHECK_EQ(bb->get_var("flag", not_found), Variant(true));
+		CHECK_EQ(bb->get_var("count", not_found), Variant(42));
+		CHECK_EQ(bb->get_var("label", not_found), Variant("text"));
+		CHECK_EQ(bb->get_var("target", not_found), Variant());
+		CHECK_EQ(parent->get_var("p", not_found), Variant(1));
+
+		// * Truncated data: the blackboard is left unchanged.
+		bb->set_var("speed", 0.0);
+		parent->set_var("p", 2);
+		const int size = buffer->get_size();
+		buffer->resize(size - 4);
+		buffer->seek(0);
+		ERR_PRINT_OFF;
+		CHECK_EQ(bb->load_state(buffer), ERR_FILE_EOF);
+		ERR_PRINT_ON;
+		CHECK_EQ(bb->get_var("speed", not_found), Variant(0.0));
+		CHECK_EQ(parent->get_var("p", not_found), Variant(2));
+		buffer->resize(size);
+
+		// * Without parent scopes.
+		buffer->clear();
+		bb->save_state(buffer);
+		parent->set_var("p", 2);
+		buffer->seek(0);
+		CHECK_EQ(bb->load_state(buffer), OK);
+		CHECK_EQ(parent->get_var("p", not_found), Variant(2));
+	}
+
+	SUBCASE("Test bulk access") {
+		Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+		plan->set_prefetch_nodepath_vars(false);
+		plan->add_var("x", BBVariable(Variant::FLOAT));
+		plan->add_var("y", BBVariable(Variant::FLOAT));
+		plan->add_var("count", BBVariable(Variant::INT));
+		Ref<Blackboard> bb = plan->create_blackboard(nullptr);
+
+		TypedArray<StringName> names;
+		names.push_back("x");
+		names.push_back("y");
+		names.push_back("count");
+		names.push_back("extra");
+
+		const uint64_t version = bb->get_version();
+		bb->set_vars_from_floats(names, PackedFloat64Array{ 1.5, -2.0, 3.0, 4.5 });
+		CHECK_EQ(bb->get_version(), version + 2); // Adding "extra" counts separately.
+		CHECK_EQ(bb->get_var("x", not_found), Variant(1.5));
+		CHECK_EQ(bb->get_var("y", not_found), Variant(-2.0));
+		CHECK_EQ(bb->get_var("count", not_found), Variant(3.0)); // Duck-typing.
+		CHECK_EQ(bb->get_var("extra", not_found), Variant(4.5));
+		CHECK_EQ(bb->get_vars_as_ints(names), PackedInt64Array{ 1, -2, 3, 4 });
+
+		bb->set_vars(names, Array::make(0.5, 1.0, "str", Vector2(1, 1)));
+		Array values = bb->get_vars(names);
+		CHECK_EQ(values, Array::make(0.5, 1.0, "str", Vector2(1, 1)));
+		CHECK_EQ(bb->get_vars_as_floats(names).size(), 4);
+
+		ERR_PRINT_OFF;
+		bb->set_vars(names, Array::make(1));
+		ERR_PRINT_ON;
+		CHECK_EQ(bb->get_var("x", not_found), Variant(0.5));
+
+		// * Handles.
+		BBHandle handles[2] = { BBHandle("x"), BBHandle("y") };
+		double floats[2] = { 7.0, 8.0 };
+		bb->set_scalars_by_handles(handles, floats, 2);
+		double out_floats[2] = {};
+		bb->get_scalars_by_handles(handles, out_floats, 2);
+		CHECK_EQ(out_floats[0], 7.0);
+		CHECK_EQ(out_floats[1], 8.0);
+		Variant variants[2] = { 1, 2 };
+		bb->set_vars_by_handles(handles, variants, 2);
+		Variant out_variants[2];
+		bb->get_vars_by_handles(handles, out_variants, 2);
+		CHECK_EQ(out_variants[0], Variant(1));
+		CHECK_EQ(out_variants[1], Variant(2));
+	}
+
+	SUBCASE("Test deferred prefetch") {
+		Ref<BlackboardPlan> plan = memnew(BlackboardPlan);
+		plan->set_prefetch_deferred(true);
+		BBVariable path_var(Variant::NODE_PATH);
+		path_var.set_value(NodePath("Child"));
+		plan->add_var("node", path_var);
+
+		Node *root = memnew(Node);
+		Node *child = memnew(Node);
+		child->set_name("Child");
+		root->add_child(child);
+
+		Ref<Blackboard> bb = plan->create_blackboard(root);
+		Ref<Blackboard> discarded = plan->create_blackboard(root);
+		discarded.unref();
+		CHECK_EQ(bb->get_var("node", not_found), Variant());
+
+		BlackboardPlan::flush_prefetch();
+		CHECK_EQ(bb->get_var("node", not_found), Variant(child));
+
+		// * Values assigned before the flush are kept.
+		Ref<Blackboard> assigned = plan->create_blackboard(root);
+		assigned->set_var("node", root);
+		BlackboardPlan::flush_prefetch();
+		CHECK_EQ(assigned->get_var("node", not_found), Variant(root));
+
+		memdelete(root);
+	}
+}
+
+TEST_CASE("[SceneTree][LimboAI] Blackboard state with nodes") {
+	Node *scene_root = memnew(Node);
+	scene_root->set_name("Level");
+	SceneTree::get_singleton()->get_root()->add_child(scene_root);
+	Node *target = memnew(Node);
+	target->set_name("Target");
+	scene_root->add_child(target);
+	Node *orphan = memnew(Node);
+
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("target", target);
+	bb->set_var("orphan", orphan);
+
+	Ref<StreamPeerBuffer> buffer = memnew(StreamPeerBuffer);
+	ERR_PRINT_OFF;
+	bb->save_state(buffer); // Nodes outside the scene tree are saved as null.
+	ERR_PRINT_ON;
+	bb->set_var("target", Variant());
+	bb->set_var("orphan", Variant());
+
+	buffer->seek(0);
+	CHECK_EQ(bb->load_state(buffer), OK);
+	CHECK_EQ(bb->get_var("target"), Variant(target));
+	CHECK_EQ(bb->get_var("orphan"), Variant());
+
+	// * Node no longer exists.
+	buffer->seek(0);
+	scene_root->remove_child(target);
+	ERR_PRINT_OFF;
+	CHECK_EQ(bb->load_state(buffer), OK);
+	ERR_PRINT_ON;
+	CHECK_EQ(bb->get_var("target"), Variant());
+
+	memdelete(target);
+	memdelete(orphan);
+	memdelete(scene_root);
 }
 
 } //namespace TestBlackboard
@@ -0,0 +1,141 @@
+/**
+ * test_bt_instance.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_INSTANCE_H
+#define TEST_BT_INSTANCE_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+
+#include "core/io/stream_peer.h"
+#include "core/os/os.h"
+
+namespace TestBTInstance {
+
+TEST_CASE("[Modules][LimboAI] BTInstance") {
+	Node *dummy = memnew(Node);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> action = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(action);
+	Ref<BTInstance> inst = BTInstance::create(seq, "res://a.tres", dummy);
+
+	REQUIRE(inst->is_instance_valid());
+	CHECK_FALSE(inst->get_monitor_performance());
+	CHECK(inst->get_owner_node() == dummy);
+
+	CHECK(inst->update(0.01666) == BTTask::RUNNING);
+	CHECK(inst->get_last_status() == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(action, 1, 1, 0);
+
+	action->ret_status = BTTask::SUCCESS;
+	CHECK(inst->update(0.01666) == BTTask::SUCCESS);
+	CHECK_ENTRIES_TICKS_EXITS(action, 1, 2, 1);
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTInstance state") {
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	seq->add_child(task1);
+	seq->add_child(task2);
+	seq->initialize(dummy, bb, dummy);
+	Ref<BTInstance> inst = BTInstance::create(seq, "res://a.tres", dummy);
+
+	bb->set_var("health", 10);
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 0);
+
+	Ref<StreamPeerBuffer> buffer = memnew(StreamPeerBuffer);
+	inst->save_state(buffer);
+
+	seq->abort();
+	bb->set_var("health", 0);
+	CHECK(seq->get_status() == BTTask::FRESH);
+
+	buffer->seek(0);
+	REQUIRE(inst->load_state(buffer) == OK);
+	CHECK(buffer->get_available_bytes() == 0);
+	CHECK(inst->get_last_status() == BTTask::RUNNING);
+	CHECK(seq->get_status() == BTTask::RUNNING);
+	CHECK(task1->get_status() == BTTask::SUCCESS);
+	CHECK(task2->get_status() == BTTask::RUNNING);
+	CHECK(task2->get_elapsed_time() == doctest::Approx(0.1));
+	CHECK(bb->get_var("health", 0) == Variant(10));
+
+	// * Resumes from the running child.
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 3, 1);
+
+	// * Compiled execution resumes from the same point.
+	buffer->seek(0);
+	inst->set_compiled_execution(true);
+	REQUIRE(inst->load_state(buffer) == OK);
+	CHECK(inst->update(0.1) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 4, 1);
+
+	// * Mismatched tree structure: the previous state is kept.
+	seq->add_child(memnew(BTTestAction(BTTask::SUCCESS)));
+	bb->set_var("health", 5);
+	task2->abort();
+	buffer->seek(0);
+	ERR_PRINT_OFF;
+	CHECK(inst->load_state(buffer) == ERR_INVALID_DATA);
+	ERR_PRINT_ON;
+	CHECK(bb->get_var("health", 0) == Variant(5));
+	CHECK(seq->get_status() == BTTask::RUNNING);
+	CHECK(task2->get_status() == BTTask::FRESH);
+
+	memdelete(dummy);
+}
+
+// * Benchmark: overhead of BTInstance::update() on top of executing an empty tree.
+// * Run explicitly with: --test-case="*BTInstance update overhead*" --no-skip
+TEST_CASE("[Modules][LimboAI][Benchmark] BTInstance update overhead" * doctest::skip()) {
+	const int num_updates = 1000000;
+
+	Node *dummy = memnew(Node);
+	Ref<BTSequence> root = memnew(BTSequence);
+	Ref<BTInstance> inst = BTInstance::create(root, "res://a.tres", dummy);
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_updates; i++) {
+		root->execute(0.01666);
+	}
+	uint64_t execute_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_updates; i++) {
+		inst->update(0.01666);
+	}
+	uint64_t update_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	MESSAGE(vformat("%d updates of an empty tree: execute() %.1f nsec, BTInstance::update() %.1f nsec per update.",
+			num_updates, execute_usec * 1000.0 / num_updates, update_usec * 1000.0 / num_updates)
+					.utf8()
+					.get_data());
+
+	memdelete(dummy);
+}
+
+} //namespace TestBTInstance
+
+#endif // TEST_BT_INSTANCE_H
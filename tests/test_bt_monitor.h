@@ -0,0 +1,115 @@
+/**
+ * test_bt_monitor.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_MONITOR_H
+#define TEST_BT_MONITOR_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/bt_monitor.h"
+
+#include "core/config/engine.h"
+
+struct BTMonitorTestAccess {
+	static uint32_t get_bucket(uint64_t p_usec) { return BTMonitor::_get_bucket(p_usec); }
+	static double get_percentile_ms(const uint32_t *p_histogram, uint64_t p_count, double p_percentile) {
+		return BTMonitor::_get_percentile_ms(p_histogram, p_count, p_percentile);
+	}
+	static void record(BTMonitor::Entry *p_entry, uint64_t p_usec) { BTMonitor::_record(p_entry, p_usec, BTMonitor::_get_bucket(p_usec)); }
+	static void refresh(BTMonitor::Entry *p_entry) { BTMonitor::_refresh(p_entry); }
+};
+
+namespace TestBTMonitor {
+
+TEST_CASE("[Modules][LimboAI] BTMonitor histogram buckets") {
+	// * Two buckets per power of two: [2^m, 1.5 * 2^m) and [1.5 * 2^m, 2^(m+1)).
+	CHECK(BTMonitorTestAccess::get_bucket(0) == 0);
+	CHECK(BTMonitorTestAccess::get_bucket(1) == 1);
+	CHECK(BTMonitorTestAccess::get_bucket(2) == 2);
+	CHECK(BTMonitorTestAccess::get_bucket(3) == 3);
+	CHECK(BTMonitorTestAccess::get_bucket(4) == 4);
+	CHECK(BTMonitorTestAccess::get_bucket(5) == 4);
+	CHECK(BTMonitorTestAccess::get_bucket(6) == 5);
+	CHECK(BTMonitorTestAccess::get_bucket(7) == 5);
+	CHECK(BTMonitorTestAccess::get_bucket(8) == 6);
+	CHECK(BTMonitorTestAccess::get_bucket(95) == 12);
+	CHECK(BTMonitorTestAccess::get_bucket(96) == 13);
+	CHECK(BTMonitorTestAccess::get_bucket(127) == 13);
+	CHECK(BTMonitorTestAccess::get_bucket(128) == 14);
+
+	// * Values past the last bucket are clamped.
+	CHECK(BTMonitorTestAccess::get_bucket(uint64_t(1) << 31) == 62);
+	CHECK(BTMonitorTestAccess::get_bucket(uint64_t(3) << 30) == 63);
+	CHECK(BTMonitorTestAccess::get_bucket(uint64_t(1) << 32) == 63);
+	CHECK(BTMonitorTestAccess::get_bucket(UINT64_MAX) == 63);
+}
+
+TEST_CASE("[Modules][LimboAI] BTMonitor percentiles") {
+	uint32_t histogram[BTMonitor::HISTOGRAM_SIZE] = {};
+	CHECK(BTMonitorTestAccess::get_percentile_ms(histogram, 0, 0.5) == 0.0);
+
+	// * 9 samples in [96, 128) usec, and 1 sample in [4096, 6144) usec.
+	histogram[13] = 9;
+	histogram[24] = 1;
+	// * Percentiles are reported as the upper bound of the bucket.
+	CHECK(BTMonitorTestAccess::get_percentile_ms(histogram, 10, 0.5) == doctest::Approx(0.128));
+	CHECK(BTMonitorTestAccess::get_percentile_ms(histogram, 10, 0.9) == doctest::Approx(0.128));
+	CHECK(BTMonitorTestAccess::get_percentile_ms(histogram, 10, 0.99) == doctest::Approx(6.144));
+	CHECK(BTMonitorTestAccess::get_percentile_ms(histogram, 10, 1.0) == doctest::Approx(6.144));
+
+	// * Every value of a bucket is within its upper bound.
+	for (uint64_t usec = 1; usec < 100000; usec = usec * 3 / 2 + 1) {
+		uint32_t single[BTMonitor::HISTOGRAM_SIZE] = {};
+		single[BTMonitorTestAccess::get_bucket(usec)] = 1;
+		CHECK(BTMonitorTestAccess::get_percentile_ms(single, 1, 0.5) * 1000.0 >= double(usec));
+	}
+}
+
+TEST_CASE("[Modules][LimboAI] BTMonitor refresh") {
+	BTMonitor::Entry entry;
+	for (int i = 0; i < 9; i++) {
+		BTMonitorTestAccess::record(&entry, 100);
+	}
+	BTMonitorTestAccess::record(&entry, 5000);
+
+	// * Recorded updates are aggregated over the window.
+	BTMonitorTestAccess::refresh(&entry);
+	CHECK(entry.snapshot_updates == 10);
+	CHECK(entry.snapshot_total_usec == 5900);
+	CHECK(entry.snapshot_histogram[13] == 9);
+	CHECK(entry.snapshot_histogram[24] == 1);
+	CHECK(entry.values[BTMonitor::METRIC_P50_MS] == doctest::Approx(0.128));
+	CHECK(entry.values[BTMonitor::METRIC_P99_MS] == doctest::Approx(6.144));
+
+	// * Reads within a short interval share the same window.
+	BTMonitorTestAccess::record(&entry, 1000);
+	BTMonitorTestAccess::refresh(&entry);
+	CHECK(entry.snapshot_updates == 10);
+	CHECK(entry.values[BTMonitor::METRIC_P50_MS] == doctest::Approx(0.128));
+
+	// * The next window only includes updates recorded since the previous one.
+	for (int i = 0; i < 3; i++) {
+		BTMonitorTestAccess::record(&entry, 1000);
+	}
+	entry.snapshot_time_usec = 1; // Expire the window.
+	entry.snapshot_frames = Engine::get_singleton()->get_process_frames() - 2;
+	BTMonitorTestAccess::refresh(&entry);
+	CHECK(entry.snapshot_updates == 14);
+	CHECK(entry.snapshot_total_usec == 9900);
+	CHECK(entry.values[BTMonitor::METRIC_TOTAL_MS] == doctest::Approx(2.0)); // 4 ms over 2 frames.
+	CHECK(entry.values[BTMonitor::METRIC_P50_MS] == doctest::Approx(1.024));
+	CHECK(entry.values[BTMonitor::METRIC_P99_MS] == doctest::Approx(1.024));
+	CHECK(entry.values[BTMonitor::METRIC_TICKS_PER_SEC] > 0.0);
+}
+
+} //namespace TestBTMonitor
+
+#endif // TEST_BT_MONITOR_H
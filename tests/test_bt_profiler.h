@@ -0,0 +1,105 @@
+/**
+ * test_bt_profiler.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_PROFILER_H
+#define TEST_BT_PROFILER_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/bt_profiler.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+
+namespace TestBTProfiler {
+
+#ifdef DEBUG_ENABLED
+
+inline Ref<BTInstance> _make_instance(Node *p_owner, Ref<BTTestAction> &r_running) {
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	r_running = Ref<BTTestAction>(memnew(BTTestAction(BTTask::RUNNING)));
+	seq->add_child(task1);
+	seq->add_child(r_running);
+	return BTInstance::create(seq, "res://profiled.tres", p_owner);
+}
+
+TEST_CASE("[Modules][LimboAI] BTProfiler") {
+	BTProfiler *profiler = BTProfiler::get_singleton();
+	REQUIRE(profiler != nullptr);
+	profiler->clear();
+
+	Node *dummy = memnew(Node);
+	Ref<BTTestAction> running1;
+	Ref<BTTestAction> running2;
+	Ref<BTInstance> inst1 = _make_instance(dummy, running1);
+	Ref<BTInstance> inst2 = _make_instance(dummy, running2);
+
+	// * Nothing is recorded while disabled.
+	inst1->update(0.01666);
+	CHECK(profiler->get_profiled_trees().is_empty());
+
+	profiler->set_enabled(true);
+	inst1->update(0.01666);
+	inst1->update(0.01666);
+	inst2->update(0.01666);
+	profiler->set_enabled(false);
+	inst1->update(0.01666);
+
+	REQUIRE(profiler->get_profiled_trees().size() == 1);
+	CHECK(profiler->get_profiled_trees()[0] == "res://profiled.tres");
+
+	// * Records are aggregated across instances of the same tree, and listed in pre-order.
+	Array profile = profiler->get_tree_profile("res://profiled.tres");
+	REQUIRE(profile.size() == 3);
+	Dictionary root = profile[0];
+	Dictionary task1 = profile[1];
+	Dictionary task2 = profile[2];
+	CHECK(int(root["parent"]) == -1);
+	CHECK(int(task1["parent"]) == 0);
+	CHECK(int(task2["parent"]) == 0);
+	CHECK(int(root["ticks"]) == 3);
+	CHECK(int(task1["ticks"]) == 3);
+	CHECK(int(task2["ticks"]) == 3);
+	CHECK(double(root["inclusive_usec"]) >= double(root["exclusive_usec"]));
+	CHECK(double(root["inclusive_usec"]) >= double(task2["inclusive_usec"]));
+
+	// * Every ticked task is listed in the collapsed stacks.
+	PackedStringArray stacks = profiler->get_collapsed_stacks().split("\n", false);
+	CHECK(stacks.size() == 3);
+
+	// * Records are reset when the tree with the same path has a different structure, even with the same number of tasks.
+	Ref<BTSelector> sel = memnew(BTSelector);
+	sel->add_child(memnew(BTTestAction(BTTask::FAILURE)));
+	sel->add_child(memnew(BTTestAction(BTTask::RUNNING)));
+	Ref<BTInstance> inst3 = BTInstance::create(sel, "res://profiled.tres", dummy);
+	profiler->set_enabled(true);
+	inst3->update(0.01666);
+	profiler->set_enabled(false);
+	profile = profiler->get_tree_profile("res://profiled.tres");
+	REQUIRE(profile.size() == 3);
+	root = profile[0];
+	CHECK(String(root["name"]) == sel->get_task_name());
+	CHECK(int(root["ticks"]) == 1);
+
+	profiler->clear();
+	CHECK(profiler->get_profiled_trees().is_empty());
+	CHECK(profiler->get_tree_profile("res://profiled.tres").is_empty());
+
+	memdelete(dummy);
+}
+
+#endif // DEBUG_ENABLED
+
+} //namespace TestBTProfiler
+
+#endif // TEST_BT_PROFILER_H
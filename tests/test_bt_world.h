@@ -0,0 +1,406 @@
+/**
+ * test_bt_world.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_BT_WORLD_H
+#define TEST_BT_WORLD_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/bt_instance.h"
+#include "modules/limboai/bt/bt_world.h"
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
+#include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/blackboard/shared_blackboard.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_set_var.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/util/limbo_task_db.h"
+#include "modules/limboai/util/limbo_utility.h"
+
+#include "core/os/os.h"
+#include "core/os/thread.h"
+
+namespace TestBTWorld {
+
+class TestThreadRecorder : public RefCounted {
+	GDCLASS(TestThreadRecorder, RefCounted);
+
+public:
+	int value = 0;
+	bool set_on_worker_thread = false;
+
+	void set_value(int p_value) {
+		value = p_value;
+		set_on_worker_thread = set_on_worker_thread || !Thread::is_main_thread();
+	}
+	int get_value() const { return value; }
+
+	static void _bind_methods() {
+		ClassDB::bind_method(D_METHOD("set_value", "value"), &TestThreadRecorder::set_value);
+		ClassDB::bind_method(D_METHOD("get_value"), &TestThreadRecorder::get_value);
+
+		ADD_PROPERTY(PropertyInfo(Variant::INT, "value"), "set_value", "get_value");
+	}
+};
+
+inline Ref<BTInstance> _make_instance(Node *p_owner, const String &p_path, Ref<BTTestAction> &r_action) {
+	Ref<BTSequence> seq = memnew(BTSequence);
+	r_action = Ref<BTTestAction>(memnew(BTTestAction(BTTask::RUNNING)));
+	seq->add_child(r_action);
+	return BTInstance::create(seq, p_path, p_owner);
+}
+
+TEST_CASE("[Modules][LimboAI] BTWorld") {
+	Node *dummy = memnew(Node);
+	BTWorld *world = memnew(BTWorld);
+
+	Ref<BTTestAction> action1;
+	Ref<BTTestAction> action2;
+	Ref<BTTestAction> action3;
+	Ref<BTInstance> inst1 = _make_instance(dummy, "res://a.tres", action1);
+	Ref<BTInstance> inst2 = _make_instance(dummy, "res://b.tres", action2);
+	Ref<BTInstance> inst3 = _make_instance(dummy, "res://a.tres", action3);
+
+	world->register_instance(inst1);
+	world->register_instance(inst2);
+	world->register_instance(inst3);
+	world->register_instance(inst1); // Registering twice has no effect.
+	CHECK(world->get_instance_count() == 3);
+	CHECK(world->get_batch_count() == 2);
+	CHECK(world->has_instance(inst2));
+
+	world->update(0.01666);
+	CHECK(inst1->get_last_status() == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(action1, 1, 1, 0);
+	CHECK_ENTRIES_TICKS_EXITS(action2, 1, 1, 0);
+	CHECK_ENTRIES_TICKS_EXITS(action3, 1, 1, 0);
+
+	world->update(0.01666);
+	CHECK(action1->get_elapsed_time() == doctest::Approx(0.01666));
+	CHECK_ENTRIES_TICKS_EXITS(action1, 1, 2, 0);
+	CHECK_ENTRIES_TICKS_EXITS(action2, 1, 2, 0);
+	CHECK_ENTRIES_TICKS_EXITS(action3, 1, 2, 0);
+
+	SUBCASE("When unregistered") {
+		world->unregister_instance(inst2);
+		CHECK_FALSE(world->has_instance(inst2));
+		CHECK(world->get_instance_count() == 2);
+		CHECK(world->get_batch_count() == 1);
+
+		world->update(0.01666);
+		CHECK_ENTRIES_TICKS_EXITS(action1, 1, 3, 0);
+		CHECK_ENTRIES_TICKS_EXITS(action2, 1, 2, 0);
+		CHECK_ENTRIES_TICKS_EXITS(action3, 1, 3, 0);
+	}
+	SUBCASE("When cleared") {
+		world->clear_instances();
+		CHECK(world->get_instance_count() == 0);
+		CHECK(world->get_batch_count() == 0);
+
+		world->update(0.01666);
+		CHECK_ENTRIES_TICKS_EXITS(action1, 1, 2, 0);
+		CHECK_ENTRIES_TICKS_EXITS(action2, 1, 2, 0);
+		CHECK_ENTRIES_TICKS_EXITS(action3, 1, 2, 0);
+	}
+
+	memdelete(world);
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTWorld with tick divisor") {
+	Node *dummy = memnew(Node);
+	BTWorld *world = memnew(BTWorld);
+	world->set_tick_divisor(2);
+
+	Ref<BTTestAction> actions[4];
+	Ref<BTInstance> instances[4];
+	for (int i = 0; i < 4; i++) {
+		instances[i] = _make_instance(dummy, "res://a.tres", actions[i]);
+		world->register_instance(instances[i]);
+	}
+
+	// * Half of the instances are updated each frame in round-robin.
+	world->update(0.1);
+	CHECK(world->get_last_update_count() == 2);
+	CHECK_ENTRIES_TICKS_EXITS(actions[0], 1, 1, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[1], 1, 1, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[2], 0, 0, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[3], 0, 0, 0);
+
+	world->update(0.1);
+	CHECK(world->get_last_update_count() == 2);
+	CHECK_ENTRIES_TICKS_EXITS(actions[0], 1, 1, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[1], 1, 1, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[2], 1, 1, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[3], 1, 1, 0);
+
+	// * Skipped frames are included in the delta.
+	world->update(0.1);
+	CHECK_ENTRIES_TICKS_EXITS(actions[0], 1, 2, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[2], 1, 1, 0);
+	CHECK(actions[0]->get_elapsed_time() == doctest::Approx(0.2));
+
+	world->update(0.1);
+	CHECK_ENTRIES_TICKS_EXITS(actions[2], 1, 2, 0);
+	CHECK(actions[2]->get_elapsed_time() == doctest::Approx(0.2));
+
+	// * Unregistering keeps the round-robin position.
+	world->unregister_instance(instances[0]);
+	world->update(0.1);
+	CHECK(world->get_last_update_count() == 2);
+	CHECK_ENTRIES_TICKS_EXITS(actions[1], 1, 3, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[2], 1, 3, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[3], 1, 2, 0);
+
+	world->clear_instances();
+	memdelete(world);
+	memdelete(dummy);
+}
+
+inline Ref<BTInstance> _make_counter_instance(Node *p_owner, int p_step) {
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_var("counter", 0);
+
+	Ref<BBVariant> step = memnew(BBVariant);
+	step->set_type(Variant::INT);
+	step->set_saved_value(p_step);
+	Ref<BTSetVar> set_var = memnew(BTSetVar);
+	set_var->set_variable("counter");
+	set_var->set_operation(LimboUtility::OPERATION_ADDITION);
+	set_var->set_value(step);
+
+	Ref<BTSequence> seq = memnew(BTSequence);
+	seq->add_child(set_var);
+	seq->initialize(p_owner, bb, p_owner);
+	return BTInstance::create(seq, "res://counter.tres", p_owner);
+}
+
+TEST_CASE("[Modules][LimboAI] BTWorld with threads") {
+	REQUIRE(LimboTaskDB::is_task_thread_safe("BTSequence"));
+	REQUIRE(LimboTaskDB::is_task_thread_safe("BTSetVar"));
+
+	const int num_instances = 200;
+	Node *dummy = memnew(Node);
+	BTWorld *sequential = memnew(BTWorld);
+	BTWorld *threaded = memnew(BTWorld);
+	threaded->set_use_threads(true);
+
+	Vector<Ref<BTInstance>> sequential_instances;
+	Vector<Ref<BTInstance>> threaded_instances;
+	for (int i = 0; i < num_instances; i++) {
+		sequential_instances.push_back(_make_counter_instance(dummy, i));
+		sequential->register_instance(sequential_instances[i]);
+		threaded_instances.push_back(_make_counter_instance(dummy, i));
+		threaded->register_instance(threaded_instances[i]);
+	}
+	// * Instance with a blackboard scope chain is updated on the main thread.
+	Ref<BTInstance> main_thread_inst = _make_counter_instance(dummy, 1);
+	main_thread_inst->get_blackboard()->set_parent(memnew(Blackboard));
+	threaded->register_instance(main_thread_inst);
+	// * Instance with a variable bound after registration is moved to the main thread.
+	Ref<TestThreadRecorder> recorder = memnew(TestThreadRecorder);
+	Ref<BTInstance> bound_inst = _make_counter_instance(dummy, 1);
+	threaded->register_instance(bound_inst);
+	bound_inst->get_blackboard()->bind_var_to_property("counter", recorder.ptr(), "value");
+
+	// * Thread safety is only evaluated when threads are enabled.
+	CHECK_FALSE(sequential_instances[0]->get_root_task()->has_connections("script_changed"));
+	CHECK(threaded_instances[0]->get_root_task()->has_connections("script_changed"));
+
+	for (int f = 0; f < 10; f++) {
+		sequential->update(0.01666);
+		threaded->update(0.01666);
+	}
+
+	CHECK(threaded->get_last_update_count() == num_instances + 2);
+	CHECK(main_thread_inst->get_blackboard()->get_var("counter") == Variant(10));
+	CHECK(recorder->value == 10);
+	CHECK_FALSE(recorder->set_on_worker_thread);
+	for (int i = 0; i < num_instances; i++) {
+		CHECK(threaded_instances[i]->get_last_status() == sequential_instances[i]->get_last_status());
+		CHECK(threaded_instances[i]->get_blackboard()->get_var("counter") == sequential_instances[i]->get_blackboard()->get_var("counter"));
+		CHECK(threaded_instances[i]->get_blackboard()->get_var("counter") == Variant(i * 10));
+	}
+
+	sequential->clear_instances();
+	threaded->clear_instances();
+	memdelete(sequential);
+	memdelete(threaded);
+	memdelete(dummy);
+}
+
+class BTTestSlowAction : public BTTestAction {
+	GDCLASS(BTTestSlowAction, BTTestAction);
+
+public:
+	int delay_usec = 0;
+
+protected:
+	virtual Status _tick(double p_delta) override {
+		OS::get_singleton()->delay_usec(delay_usec);
+		return BTTestAction::_tick(p_delta);
+	}
+
+public:
+	BTTestSlowAction(int p_delay_usec) :
+			BTTestAction(BTTask::RUNNING) { delay_usec = p_delay_usec; }
+	BTTestSlowAction() {}
+};
+
+TEST_CASE("[Modules][LimboAI] BTWorld with threads and frame budget") {
+	Node *dummy = memnew(Node);
+	BTWorld *world = memnew(BTWorld);
+	world->set_use_threads(true);
+	world->set_frame_budget_usec(1000);
+
+	// * Slow instances are not thread-safe, so they are queued for the main thread.
+	const int num_slow = 4;
+	Ref<BTTestSlowAction> actions[num_slow];
+	Ref<BTInstance> instances[num_slow];
+	for (int i = 0; i < num_slow; i++) {
+		actions[i] = Ref<BTTestSlowAction>(memnew(BTTestSlowAction(5000)));
+		Ref<BTSequence> seq = memnew(BTSequence);
+		seq->add_child(actions[i]);
+		instances[i] = BTInstance::create(seq, "res://slow.tres", dummy);
+		world->register_instance(instances[i]);
+	}
+	// * Thread-safe instances are updated on worker threads.
+	Ref<BTInstance> counter = _make_counter_instance(dummy, 1);
+	world->register_instance(counter);
+
+	// * Costs are not known before the first update, so all instances are queued.
+	world->update(0.01666);
+	CHECK(world->get_last_update_count() == num_slow + 1);
+	for (int i = 0; i < num_slow; i++) {
+		CHECK_ENTRIES_TICKS_EXITS(actions[i], 1, 1, 0);
+	}
+
+	// * Queuing stops once the estimated cost exceeds the budget.
+	world->update(0.01666);
+	CHECK(world->get_last_update_count() == 1);
+	CHECK_ENTRIES_TICKS_EXITS(actions[0], 1, 2, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[1], 1, 1, 0);
+
+	// * The remaining instances are updated in the following updates.
+	world->update(0.01666);
+	CHECK(world->get_last_update_count() == 1);
+	CHECK_ENTRIES_TICKS_EXITS(actions[1], 1, 2, 0);
+	CHECK_ENTRIES_TICKS_EXITS(actions[2], 1, 1, 0);
+
+	// * Without the budget, all instances are queued again.
+	world->set_frame_budget_usec(0);
+	world->update(0.01666);
+	CHECK(world->get_last_update_count() == num_slow + 1);
+
+	world->clear_instances();
+	memdelete(world);
+	memdelete(dummy);
+}
+
+inline Ref<BTInstance> _make_shared_step_instance(Node *p_owner, const Ref<Blackboard> &p_shared) {
+	Ref<Blackboard> bb = memnew(Blackboard);
+	bb->set_parent(p_shared);
+	bb->set_var("counter", 0);
+
+	Ref<BBVariant> step = memnew(BBVariant);
+	step->set_type(Variant::INT);
+	step->set_value_source(BBParam::BLACKBOARD_VAR);
+	step->set_variable("step");
+	Ref<BTSetVar> set_var = memnew(BTSetVar);
+	set_var->set_variable("counter");
+	set_var->set_operation(LimboUtility::OPERATION_ADDITION);
+	set_var->set_value(step);
+
+	Ref<BTSequence> seq = memnew(BTSequence);
+	seq->add_child(set_var);
+	seq->initialize(p_owner, bb, p_owner);
+	return BTInstance::create(seq, "res://shared_step.tres", p_owner);
+}
+
+TEST_CASE("[Modules][LimboAI] BTWorld with threads and shared scope") {
+	Ref<SharedBlackboard> shared = SharedBlackboard::get_scope("test_bt_world");
+	shared->set_var("step", 2);
+	shared->publish();
+	const uint64_t shared_version = shared->get_version();
+
+	const int num_instances = 200;
+	Node *dummy = memnew(Node);
+	BTWorld *world = memnew(BTWorld);
+	world->set_use_threads(true);
+
+	Vector<Ref<BTInstance>> instances;
+	for (int i = 0; i < num_instances; i++) {
+		instances.push_back(_make_shared_step_instance(dummy, shared));
+		REQUIRE(instances[i]->get_blackboard()->is_isolated());
+		world->register_instance(instances[i]);
+	}
+
+	for (int f = 0; f < 10; f++) {
+		world->update(0.01666);
+	}
+
+	// * Agents modify only their own scopes - the shared scope is left untouched.
+	CHECK(world->get_last_update_count() == num_instances);
+	CHECK(shared->get_version() == shared_version);
+	for (int i = 0; i < num_instances; i++) {
+		CHECK(instances[i]->get_blackboard()->get_var("counter") == Variant(20));
+	}
+
+	world->clear_instances();
+	memdelete(world);
+	memdelete(dummy);
+	SharedBlackboard::remove_scope("test_bt_world");
+}
+
+// * Benchmark: per-instance updates (as done by each BTPlayer) vs batched BTWorld update.
+// * Run explicitly with: --test-case="*BTWorld benchmark*" --no-skip
+TEST_CASE("[Modules][LimboAI][Benchmark] BTWorld benchmark" * doctest::skip()) {
+	const int num_instances = 5000;
+	const int num_frames = 100;
+
+	Node *dummy = memnew(Node);
+	BTWorld *world = memnew(BTWorld);
+	Vector<Ref<BTInstance>> instances;
+	for (int i = 0; i < num_instances; i++) {
+		Ref<BTTestAction> action;
+		Ref<BTInstance> inst = _make_instance(dummy, "res://a.tres", action);
+		instances.push_back(inst);
+		world->register_instance(inst);
+	}
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int f = 0; f < num_frames; f++) {
+		for (int i = 0; i < num_instances; i++) {
+			instances[i]->update(0.01666);
+		}
+	}
+	uint64_t per_instance_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int f = 0; f < num_frames; f++) {
+		world->update(0.01666);
+	}
+	uint64_t batched_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	MESSAGE(vformat("%d instances, %d frames: per-instance %d usec/frame, batched %d usec/frame.",
+			num_instances, num_frames, per_instance_usec / num_frames, batched_usec / num_frames)
+					.utf8()
+					.get_data());
+
+	world->clear_instances();
+	instances.clear();
+	memdelete(world);
+	memdelete(dummy);
+}
+
+} //namespace TestBTWorld
+
+#endif // TEST_BT_WORLD_H
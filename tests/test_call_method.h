@@ -21,6 +21,7 @@
 
 #include "core/os/memory.h"
 #include "core/variant/array.h"
+#include "scene/main/window.h"
 
 namespace TestCallMethod {
 
@@ -115,6 +116,39 @@ TEST_CASE("[Modules][LimboAI] BTCallMethod") {
 	}
 }
 
+TEST_CASE("[SceneTree][LimboAI] BTCallMethod node cache") {
+	Node *scene_root = memnew(Node);
+	SceneTree::get_singleton()->get_root()->add_child(scene_root);
+	Node *target = memnew(Node);
+	target->set_name("Target");
+	scene_root->add_child(target);
+
+	Ref<BTCallMethod> cm = memnew(BTCallMethod);
+	Ref<BBNode> node_param = memnew(BBNode);
+	node_param->set_saved_value(NodePath("Target"));
+	cm->set_node_param(node_param);
+	cm->set_method("set_meta");
+	TypedArray<BBVariant> args;
+	args.push_back(memnew(BBVariant("ticked")));
+	args.push_back(memnew(BBVariant(true)));
+	cm->set_args(args);
+	cm->initialize(scene_root, memnew(Blackboard), scene_root);
+
+	CHECK(cm->execute(0.01666) == BTTask::SUCCESS);
+	CHECK(target->has_meta("ticked"));
+
+	// * Cached node is invalidated when it exits the tree.
+	scene_root->remove_child(target);
+	Node *replacement = memnew(Node);
+	replacement->set_name("Target");
+	scene_root->add_child(replacement);
+	CHECK(cm->execute(0.01666) == BTTask::SUCCESS);
+	CHECK(replacement->has_meta("ticked"));
+
+	memdelete(target);
+	memdelete(scene_root);
+}
+
 } //namespace TestCallMethod
 
 #endif // TEST_CALL_METHOD_H
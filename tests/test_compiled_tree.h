@@ -0,0 +1,144 @@
+/**
+ * test_compiled_tree.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_COMPILED_TREE_H
+#define TEST_COMPILED_TREE_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/bt/bt_compiled_tree.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
+#include "modules/limboai/bt/tasks/decorators/bt_invert.h"
+
+namespace TestCompiledTree {
+
+TEST_CASE("[Modules][LimboAI] BTCompiledTree") {
+	Ref<BTSequence> seq = memnew(BTSequence);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTSelector> sel = memnew(BTSelector);
+	Ref<BTInvert> inv = memnew(BTInvert);
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task3 = memnew(BTTestAction(BTTask::RUNNING));
+	Ref<BTTestAction> task4 = memnew(BTTestAction(BTTask::SUCCESS));
+
+	// seq
+	//   task1
+	//   sel
+	//     inv
+	//       task2
+	//     task3
+	//   task4
+	seq->add_child(task1);
+	seq->add_child(sel);
+	sel->add_child(inv);
+	inv->add_child(task2);
+	sel->add_child(task3);
+	seq->add_child(task4);
+
+	BTCompiledTree compiled;
+	REQUIRE(compiled.compile(seq));
+	CHECK(compiled.get_node_count() == 7);
+	CHECK(compiled.get_native_node_count() == 3);
+
+	// * First execution: task3 is RUNNING.
+	CHECK(compiled.execute(0.01666) == BTTask::RUNNING);
+	CHECK(seq->get_status() == BTTask::RUNNING);
+	CHECK(sel->get_status() == BTTask::RUNNING);
+	CHECK(inv->get_status() == BTTask::FAILURE);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task3, 1, 1, 0);
+	CHECK_ENTRIES_TICKS_EXITS(task4, 0, 0, 0);
+
+	// * Second execution: resumes from the running task.
+	CHECK(compiled.execute(0.01666) == BTTask::RUNNING);
+	CHECK(seq->get_elapsed_time() == doctest::Approx(0.01666));
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task3, 1, 2, 0);
+	CHECK_ENTRIES_TICKS_EXITS(task4, 0, 0, 0);
+
+	// * Third execution: task3 succeeds, tree completes.
+	task3->ret_status = BTTask::SUCCESS;
+	CHECK(compiled.execute(0.01666) == BTTask::SUCCESS);
+	CHECK(seq->get_status() == BTTask::SUCCESS);
+	CHECK(seq->get_elapsed_time() == doctest::Approx(0.0));
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task3, 1, 3, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task4, 1, 1, 1);
+
+	// * Fourth execution: starts anew.
+	task3->ret_status = BTTask::RUNNING;
+	CHECK(compiled.execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 2, 2, 2);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 2, 2, 2);
+	CHECK_ENTRIES_TICKS_EXITS(task3, 2, 4, 1);
+
+	// * Abort: running task exits, tree is FRESH.
+	compiled.abort();
+	CHECK(seq->get_status() == BTTask::FRESH);
+	CHECK(task3->get_status() == BTTask::FRESH);
+	CHECK_ENTRIES_TICKS_EXITS(task3, 2, 4, 2);
+
+	// * Abort from outside the interpreter is picked up on the next execution.
+	CHECK(compiled.execute(0.01666) == BTTask::RUNNING);
+	seq->abort();
+	CHECK(compiled.execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 4, 4, 4);
+	CHECK_ENTRIES_TICKS_EXITS(task3, 4, 6, 3);
+}
+
+struct TestTree {
+	Ref<BTSelector> root;
+	Ref<BTTestAction> task1;
+	Ref<BTTestAction> task2;
+	Ref<BTTestAction> task3;
+
+	TestTree() {
+		root = Ref<BTSelector>(memnew(BTSelector));
+		Ref<BTSequence> seq = memnew(BTSequence);
+		task1 = Ref<BTTestAction>(memnew(BTTestAction(BTTask::SUCCESS)));
+		task2 = Ref<BTTestAction>(memnew(BTTestAction(BTTask::FAILURE)));
+		task3 = Ref<BTTestAction>(memnew(BTTestAction(BTTask::RUNNING)));
+		root->add_child(seq);
+		seq->add_child(task1);
+		seq->add_child(task2);
+		root->add_child(task3);
+	}
+};
+
+TEST_CASE("[Modules][LimboAI] BTCompiledTree matches regular execution") {
+	TestTree regular;
+	TestTree lowered;
+
+	BTCompiledTree compiled;
+	REQUIRE(compiled.compile(lowered.root));
+
+	for (int i = 0; i < 5; i++) {
+		if (i == 3) {
+			regular.task3->ret_status = BTTask::SUCCESS;
+			lowered.task3->ret_status = BTTask::SUCCESS;
+		}
+		CHECK(compiled.execute(0.01666) == regular.root->execute(0.01666));
+		CHECK(lowered.root->get_status() == regular.root->get_status());
+		CHECK(lowered.root->get_elapsed_time() == doctest::Approx(regular.root->get_elapsed_time()));
+		CHECK_ENTRIES_TICKS_EXITS(lowered.task1, regular.task1->num_entries, regular.task1->num_ticks, regular.task1->num_exits);
+		CHECK_ENTRIES_TICKS_EXITS(lowered.task2, regular.task2->num_entries, regular.task2->num_ticks, regular.task2->num_exits);
+		CHECK_ENTRIES_TICKS_EXITS(lowered.task3, regular.task3->num_entries, regular.task3->num_ticks, regular.task3->num_exits);
+	}
+}
+
+} //namespace TestCompiledTree
+
+#endif // TEST_COMPILED_TREE_H
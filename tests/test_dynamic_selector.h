@@ -14,8 +14,10 @@
 
 #include "limbo_test.h"
 
+#include "modules/limboai/blackboard/blackboard.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/composites/bt_dynamic_selector.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
 
 namespace TestDynamicSelector {
 
@@ -116,6 +118,112 @@ TEST_CASE("[Modules][LimboAI] BTDynamicSelector") {
 	}
 }
 
+TEST_CASE("[Modules][LimboAI] BTDynamicSelector in reactive mode") {
+	Ref<BTDynamicSelector> comp = memnew(BTDynamicSelector);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::FAILURE));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	task1->read_var = "foo";
+	comp->add_child(task1);
+	comp->add_child(task2);
+	comp->set_reactive(true);
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	comp->initialize(dummy, bb, dummy);
+
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 0);
+
+	// * Blackboard hasn't changed: only the running task is executed.
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 0);
+
+	// * Variables not read by the preceding tasks don't matter.
+	bb->set_var("bar", 1);
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 3, 0);
+
+	// * Variable read by the preceding task has changed: it's reevaluated.
+	bb->set_var("foo", 1);
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 2, 2, 2);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 4, 0);
+
+	task1->ret_status = BTTask::SUCCESS;
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 2, 2, 2);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 5, 0);
+
+	bb->set_var("foo", 2);
+	CHECK(comp->execute(0.01666) == BTTask::SUCCESS);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 3, 3, 3);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 5, 1);
+	CHECK(task2->get_status() == BTTask::FRESH);
+
+	// * Bound variables are always considered changed.
+	task1->ret_status = BTTask::FAILURE;
+	bb->bind_var_to_property("foo", dummy, "editor_description");
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	const int num_task1_ticks = task1->num_ticks;
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_EQ(task1->num_ticks, num_task1_ticks + 1);
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTDynamicSelector in guarded mode") {
+	Ref<BTDynamicSelector> comp = memnew(BTDynamicSelector);
+	Ref<BTSequence> branch1 = memnew(BTSequence);
+	Ref<BTTestCondition> guard = memnew(BTTestCondition(BTTask::FAILURE));
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	branch1->add_child(guard);
+	branch1->add_child(task1);
+	comp->add_child(branch1);
+	comp->add_child(task2);
+	comp->set_guarded(true);
+
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK(guard->num_ticks == 1);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 0, 0, 0);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 0);
+
+	// * Only the guard of the preceding branch is evaluated.
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK(guard->num_ticks == 2);
+	CHECK(guard->get_status() == BTTask::FAILURE);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 0, 0, 0);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 0);
+
+	// * When the guard passes, the branch is executed and interrupts the running task.
+	// * The branch doesn't evaluate the guard again.
+	guard->ret_status = BTTask::SUCCESS;
+	CHECK(comp->execute(0.01666) == BTTask::SUCCESS);
+	CHECK(guard->num_ticks == 3);
+	CHECK(branch1->get_status() == BTTask::SUCCESS);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 1);
+	CHECK(task2->get_status() == BTTask::FRESH);
+
+	// * Branch fails after its guard, and the next task runs.
+	task1->ret_status = BTTask::FAILURE;
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK(guard->num_ticks == 4);
+	CHECK(branch1->get_status() == BTTask::FAILURE);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 2, 3, 1);
+
+	// * Reentering the finished branch keeps the status of the guard evaluated in this tick.
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK(guard->num_ticks == 5);
+	CHECK(guard->get_status() == BTTask::SUCCESS);
+	CHECK(branch1->get_status() == BTTask::FAILURE);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 3, 3, 3);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 2, 4, 1);
+}
+
 } //namespace TestDynamicSelector
 
 #endif // TEST_DYNAMIC_SELECTOR_H
@@ -14,8 +14,10 @@
 
 #include "limbo_test.h"
 
+#include "modules/limboai/blackboard/blackboard.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
 #include "modules/limboai/bt/tasks/composites/bt_dynamic_sequence.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
 
 namespace TestDynamicSequence {
 
@@ -103,6 +105,100 @@ TEST_CASE("[Modules][LimboAI] BTDynamicSequence") {
 	}
 }
 
+TEST_CASE("[Modules][LimboAI] BTDynamicSequence in reactive mode") {
+	Ref<BTDynamicSequence> comp = memnew(BTDynamicSequence);
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	task1->read_var = "foo";
+	comp->add_child(task1);
+	comp->add_child(task2);
+	comp->set_reactive(true);
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	comp->initialize(dummy, bb, dummy);
+
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 0);
+
+	// * Blackboard hasn't changed: only the running task is executed.
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 0);
+
+	// * Variables not read by the preceding tasks don't matter.
+	bb->set_var("bar", 1);
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 3, 0);
+
+	// * Variable read by the preceding task has changed: it's reevaluated.
+	bb->set_var("foo", 1);
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 2, 2, 2);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 4, 0);
+
+	task1->ret_status = BTTask::FAILURE;
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 2, 2, 2);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 5, 0);
+
+	bb->set_var("foo", 2);
+	CHECK(comp->execute(0.01666) == BTTask::FAILURE);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 3, 3, 3);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 5, 1);
+	CHECK(task2->get_status() == BTTask::FRESH);
+
+	// * Bound variables are always considered changed.
+	task1->ret_status = BTTask::SUCCESS;
+	bb->bind_var_to_property("foo", dummy, "editor_description");
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	const int num_task1_ticks = task1->num_ticks;
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK_EQ(task1->num_ticks, num_task1_ticks + 1);
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTDynamicSequence in guarded mode") {
+	Ref<BTDynamicSequence> comp = memnew(BTDynamicSequence);
+	Ref<BTSequence> step1 = memnew(BTSequence);
+	Ref<BTTestCondition> guard = memnew(BTTestCondition(BTTask::SUCCESS));
+	Ref<BTTestAction> task1 = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTTestAction> task2 = memnew(BTTestAction(BTTask::RUNNING));
+	step1->add_child(guard);
+	step1->add_child(task1);
+	comp->add_child(step1);
+	comp->add_child(task2);
+	comp->set_guarded(true);
+
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK(guard->num_ticks == 1);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 0);
+
+	// * Guard passes: the preceding step is not reentered.
+	CHECK(comp->execute(0.01666) == BTTask::RUNNING);
+	CHECK(guard->num_ticks == 2);
+	CHECK(guard->get_status() == BTTask::SUCCESS);
+	CHECK(step1->get_status() == BTTask::SUCCESS);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 0);
+
+	// * Guard fails: the step is executed, fails, and the running task is aborted.
+	// * The step doesn't evaluate the guard again.
+	guard->ret_status = BTTask::FAILURE;
+	CHECK(comp->execute(0.01666) == BTTask::FAILURE);
+	CHECK(guard->num_ticks == 3);
+	CHECK(guard->get_status() == BTTask::FAILURE);
+	CHECK(step1->get_status() == BTTask::FAILURE);
+	CHECK(task1->get_status() == BTTask::FRESH);
+	CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+	CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 1);
+	CHECK(task2->get_status() == BTTask::FRESH);
+}
+
 } //namespace TestDynamicSequence
 
 #endif // TEST_DYNAMIC_SEQUENCE_H
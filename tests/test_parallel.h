@@ -42,13 +42,13 @@ TEST_CASE("[Modules][LimboAI] BTParallel with num_required_successes: 1 and num_
 
 		CHECK(par->execute(0.01666) == BTTask::SUCCESS); // When reached both conditions.
 
-		CHECK(task1->get_status() == BTTask::RUNNING);
+		CHECK(task1->get_status() == BTTask::FRESH);
 		CHECK(task2->get_status() == BTTask::SUCCESS);
-		CHECK(task3->get_status() == BTTask::FAILURE);
+		CHECK(task3->get_status() == BTTask::FRESH);
 
-		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 0); // * running
+		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1); // * aborted
 		CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 1); // * finished
-		CHECK_ENTRIES_TICKS_EXITS(task3, 1, 1, 1); // * finished
+		CHECK_ENTRIES_TICKS_EXITS(task3, 0, 0, 0); // * skipped: outcome already decided
 	}
 
 	SUBCASE("BTParallel composition {RUNNING, SUCCESS, RUNNING} and successes/failures required 1/1") {
@@ -62,13 +62,13 @@ TEST_CASE("[Modules][LimboAI] BTParallel with num_required_successes: 1 and num_
 
 		CHECK(par->execute(0.01666) == BTTask::SUCCESS);
 
-		CHECK(task1->get_status() == BTTask::RUNNING);
+		CHECK(task1->get_status() == BTTask::FRESH);
 		CHECK(task2->get_status() == BTTask::SUCCESS);
-		CHECK(task3->get_status() == BTTask::RUNNING);
+		CHECK(task3->get_status() == BTTask::FRESH);
 
-		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 0); // * running
+		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1); // * aborted
 		CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 1); // * finished
-		CHECK_ENTRIES_TICKS_EXITS(task3, 1, 1, 0); // * running
+		CHECK_ENTRIES_TICKS_EXITS(task3, 0, 0, 0); // * skipped
 	}
 
 	SUBCASE("BTParallel composition {RUNNING, FAILURE, RUNNING} and successes/failures required 1/1") {
@@ -82,13 +82,13 @@ TEST_CASE("[Modules][LimboAI] BTParallel with num_required_successes: 1 and num_
 
 		CHECK(par->execute(0.01666) == BTTask::FAILURE);
 
-		CHECK(task1->get_status() == BTTask::RUNNING);
+		CHECK(task1->get_status() == BTTask::FRESH);
 		CHECK(task2->get_status() == BTTask::FAILURE);
-		CHECK(task3->get_status() == BTTask::RUNNING);
+		CHECK(task3->get_status() == BTTask::FRESH);
 
-		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 0); // * running
+		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1); // * aborted
 		CHECK_ENTRIES_TICKS_EXITS(task2, 1, 1, 1); // * finished
-		CHECK_ENTRIES_TICKS_EXITS(task3, 1, 1, 0); // * running
+		CHECK_ENTRIES_TICKS_EXITS(task3, 0, 0, 0); // * skipped
 	}
 
 	SUBCASE("BTParallel composition {SUCCESS, RUNNING, FAILURE} with successes/failures required 3/3 (not repeating)") {
@@ -205,6 +205,37 @@ TEST_CASE("[Modules][LimboAI] BTParallel with num_required_successes: 1 and num_
 		CHECK_ENTRIES_TICKS_EXITS(task2, 1, 3, 0); // * continued
 		CHECK_ENTRIES_TICKS_EXITS(task3, 2, 2, 2); // * repeated
 	}
+
+	SUBCASE("BTParallel terminates running children once the outcome is decided in a later tick") {
+		// * Case #6: Finished children are not ticked again, and the remaining running children are aborted.
+		task1->ret_status = BTTask::SUCCESS;
+		task2->ret_status = BTTask::RUNNING;
+		task3->ret_status = BTTask::RUNNING;
+		par->set_num_successes_required(2);
+		par->set_num_failures_required(2);
+		par->set_repeat(false);
+
+		CHECK(par->execute(0.01666) == BTTask::RUNNING);
+		CHECK(par->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1); // * finished, not ticked again
+		CHECK_ENTRIES_TICKS_EXITS(task2, 1, 2, 0);
+		CHECK_ENTRIES_TICKS_EXITS(task3, 1, 2, 0);
+
+		task2->ret_status = BTTask::SUCCESS;
+		CHECK(par->execute(0.01666) == BTTask::SUCCESS);
+		CHECK(task2->get_status() == BTTask::SUCCESS);
+		CHECK(task3->get_status() == BTTask::FRESH);
+		CHECK_ENTRIES_TICKS_EXITS(task1, 1, 1, 1);
+		CHECK_ENTRIES_TICKS_EXITS(task2, 1, 3, 1);
+		CHECK_ENTRIES_TICKS_EXITS(task3, 1, 2, 1); // * aborted without a tick
+
+		// * Execution #2: Parallel starts over with all children.
+		task2->ret_status = BTTask::RUNNING;
+		CHECK(par->execute(0.01666) == BTTask::RUNNING);
+		CHECK_ENTRIES_TICKS_EXITS(task1, 2, 2, 2);
+		CHECK_ENTRIES_TICKS_EXITS(task2, 2, 4, 1);
+		CHECK_ENTRIES_TICKS_EXITS(task3, 2, 3, 1);
+	}
 }
 
 } //namespace TestParallel
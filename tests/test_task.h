@@ -14,10 +14,25 @@
 
 #include "limbo_test.h"
 
+#include "modules/limboai/blackboard/bb_param/bb_variant.h"
 #include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/bt/tasks/blackboard/bt_set_var.h"
 #include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_sequence.h"
 #include "tests/test_macros.h"
 
+#include "core/os/os.h"
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+#include "modules/gdscript/gdscript.h"
+#endif
+
+struct BTTaskTestAccess {
+	static int get_script_cache_size() { return BTTask::script_virtuals.size(); }
+	static bool is_script_cached(const Ref<Script> &p_script) { return BTTask::script_virtuals.has(p_script->get_instance_id()); }
+	static uint8_t get_script_overrides(const Ref<BTTask> &p_task) { return p_task->data.script_overrides; }
+};
+
 namespace TestTask {
 
 TEST_CASE("[Modules][LimboAI] BTTask") {
@@ -233,7 +248,220 @@ TEST_CASE("[Modules][LimboAI] BTTask") {
 		CHECK_FALSE(cloned->get_child(0) == child1);
 		CHECK_FALSE(cloned->get_child(1) == child2);
 	}
+
+	SUBCASE("Test clone_shared()") {
+		Ref<BTTestAction> task = memnew(BTTestAction);
+		Ref<BTSetVar> child = memnew(BTSetVar);
+		Ref<BBVariant> param = memnew(BBVariant);
+		child->set_value(param);
+		task->add_child(child);
+
+		Ref<BTTestAction> cloned = task->clone();
+		REQUIRE(cloned->get_child_count() == 1);
+		Ref<BTSetVar> cloned_child = cloned->get_child(0);
+		REQUIRE(cloned_child.is_valid());
+		CHECK_FALSE(cloned_child->get_value() == param);
+
+		Ref<BTTestAction> shared = task->clone_shared();
+		CHECK_FALSE(shared == task);
+		REQUIRE(shared->get_child_count() == 1);
+		Ref<BTSetVar> shared_child = shared->get_child(0);
+		REQUIRE(shared_child.is_valid());
+		CHECK_FALSE(shared_child == child);
+		CHECK(shared_child->get_value() == param);
+
+		// * Params of nested tasks are made unique as well.
+		Ref<BTSetVar> grandchild = memnew(BTSetVar);
+		grandchild->set_value(param);
+		child->add_child(grandchild);
+		Ref<BTTestAction> deep = task->clone();
+		Ref<BTSetVar> deep_grandchild = deep->get_child(0)->get_child(0);
+		REQUIRE(deep_grandchild.is_valid());
+		CHECK_FALSE(deep_grandchild->get_value() == param);
+		Ref<BTTestAction> deep_shared = task->clone_shared();
+		Ref<BTSetVar> shared_grandchild = deep_shared->get_child(0)->get_child(0);
+		REQUIRE(shared_grandchild.is_valid());
+		CHECK(shared_grandchild->get_value() == param);
+	}
+}
+
+// * Benchmark: script virtual dispatch vs native fast path in an all-native tree of 200 tasks.
+// * Tasks that are not initialized always go through GDVIRTUAL_CALL; initialized tasks skip it.
+// * Run explicitly with: --test-case="*BTTask native dispatch*" --no-skip
+TEST_CASE("[Modules][LimboAI][Benchmark] BTTask native dispatch" * doctest::skip()) {
+	const int num_ticks = 10000;
+
+	// * 200 tasks: root, 18 sequences with 10 actions each, and the last running action.
+	const int num_tasks = 200;
+	Ref<BTSequence> root = memnew(BTSequence);
+	for (int i = 0; i < 18; i++) {
+		Ref<BTSequence> seq = memnew(BTSequence);
+		for (int j = 0; j < 10; j++) {
+			seq->add_child(memnew(BTTestAction(BTTask::SUCCESS)));
+		}
+		root->add_child(seq);
+	}
+	Ref<BTTestAction> last = memnew(BTTestAction(BTTask::RUNNING));
+	root->add_child(last);
+	REQUIRE_EQ(1 + root->get_child_count() + 18 * root->get_child(0)->get_child_count(), num_tasks);
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_ticks; i++) {
+		root->execute(0.01666);
+	}
+	uint64_t virtual_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	root->initialize(dummy, bb, dummy);
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_ticks; i++) {
+		root->execute(0.01666);
+	}
+	uint64_t native_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	CHECK_EQ(last->num_ticks, num_ticks * 2);
+	MESSAGE(vformat("%d ticks of a %d-task tree: script dispatch %.2f usec, native dispatch %.2f usec per tick.",
+			num_ticks, num_tasks, virtual_usec / double(num_ticks), native_usec / double(num_ticks))
+					.utf8()
+					.get_data());
+
+	memdelete(dummy);
+}
+
+#ifdef MODULE_GDSCRIPT_ENABLED
+TEST_CASE("[Modules][LimboAI] BTTask script virtuals") {
+	Ref<GDScript> action_script = memnew(GDScript);
+	action_script->set_source_code(
+			"extends BTAction\n"
+			"var num_entries := 0\n"
+			"var num_ticks := 0\n"
+			"func _enter() -> void:\n"
+			"\tnum_entries += 1\n"
+			"func _tick(_delta: float) -> Status:\n"
+			"\tnum_ticks += 1\n"
+			"\treturn RUNNING\n");
+	REQUIRE(action_script->reload() == OK);
+
+	Ref<BTSequence> root = memnew(BTSequence);
+	Ref<BTTestAction> native = memnew(BTTestAction(BTTask::SUCCESS));
+	Ref<BTAction> scripted = memnew(BTAction);
+	scripted->set_script(action_script);
+	root->add_child(native);
+	root->add_child(scripted);
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	root->initialize(dummy, bb, dummy);
+
+	// * Script overrides are called after initialization, native tasks run as usual.
+	CHECK(root->execute(0.01666) == BTTask::RUNNING);
+	CHECK(root->execute(0.01666) == BTTask::RUNNING);
+	CHECK_EQ(int(scripted->get("num_entries")), 1);
+	CHECK_EQ(int(scripted->get("num_ticks")), 2);
+	CHECK_ENTRIES_TICKS_EXITS(native, 1, 1, 1);
+
+	memdelete(dummy);
+}
+
+TEST_CASE("[Modules][LimboAI] BTTask script virtuals cache") {
+	BTTask::clear_script_cache();
+	Ref<GDScript> action_script = memnew(GDScript);
+	action_script->set_source_code(
+			"extends BTAction\n"
+			"var num_entries := 0\n"
+			"func _tick(_delta: float) -> Status:\n"
+			"\treturn RUNNING\n");
+	REQUIRE(action_script->reload() == OK);
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	Ref<BTAction> task1 = memnew(BTAction);
+	Ref<BTAction> task2 = memnew(BTAction);
+	task1->set_script(action_script);
+	task2->set_script(action_script);
+
+	// * Tasks with the same script share the cache entry.
+	task1->initialize(dummy, bb, dummy);
+	CHECK(BTTaskTestAccess::get_script_cache_size() == 1);
+	CHECK(BTTaskTestAccess::is_script_cached(action_script));
+	task2->initialize(dummy, bb, dummy);
+	CHECK(BTTaskTestAccess::get_script_cache_size() == 1);
+	CHECK(BTTaskTestAccess::get_script_overrides(task1) == BTTaskTestAccess::get_script_overrides(task2));
+
+	// * Reloaded script with a new override: the entry is resolved again for newly initialized tasks.
+	action_script->set_source_code(
+			"extends BTAction\n"
+			"var num_entries := 0\n"
+			"func _enter() -> void:\n"
+			"\tnum_entries += 1\n"
+			"func _tick(_delta: float) -> Status:\n"
+			"\treturn RUNNING\n");
+	REQUIRE(action_script->reload() == OK);
+	action_script->emit_changed();
+	CHECK_FALSE(BTTaskTestAccess::is_script_cached(action_script));
+
+	Ref<BTAction> task3 = memnew(BTAction);
+	task3->set_script(action_script);
+	task3->initialize(dummy, bb, dummy);
+	CHECK(BTTaskTestAccess::is_script_cached(action_script));
+	CHECK(task3->execute(0.01666) == BTTask::RUNNING);
+	CHECK_EQ(int(task3->get("num_entries")), 1);
+
+	// * Cache can also be cleared explicitly.
+	BTTask::clear_script_cache();
+	CHECK(BTTaskTestAccess::get_script_cache_size() == 0);
+
+	memdelete(dummy);
+}
+
+// * Benchmark: throughput of native leaves vs GDScript leaves overriding _tick.
+// * Run explicitly with: --test-case="*BTTask script leaf throughput*" --no-skip
+TEST_CASE("[Modules][LimboAI][Benchmark] BTTask script leaf throughput" * doctest::skip()) {
+	const int num_leaves = 100;
+	const int num_ticks = 1000;
+
+	Ref<GDScript> leaf_script = memnew(GDScript);
+	leaf_script->set_source_code("extends BTAction\nfunc _tick(_delta: float) -> Status:\n\treturn SUCCESS\n");
+	REQUIRE(leaf_script->reload() == OK);
+
+	Ref<BTSequence> native_root = memnew(BTSequence);
+	Ref<BTSequence> script_root = memnew(BTSequence);
+	for (int i = 0; i < num_leaves; i++) {
+		native_root->add_child(memnew(BTTestAction(BTTask::SUCCESS)));
+		Ref<BTAction> leaf = memnew(BTAction);
+		leaf->set_script(leaf_script);
+		script_root->add_child(leaf);
+	}
+
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+	native_root->initialize(dummy, bb, dummy);
+	script_root->initialize(dummy, bb, dummy);
+
+	uint64_t start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_ticks; i++) {
+		native_root->execute(0.01666);
+	}
+	uint64_t native_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	start = OS::get_singleton()->get_ticks_usec();
+	for (int i = 0; i < num_ticks; i++) {
+		script_root->execute(0.01666);
+	}
+	uint64_t script_usec = OS::get_singleton()->get_ticks_usec() - start;
+
+	CHECK_EQ(script_root->get_status(), BTTask::SUCCESS);
+	const double num_executions = double(num_leaves) * num_ticks;
+	MESSAGE(vformat("%d leaf executions: native %.1f nsec, GDScript %.1f nsec per leaf.",
+			int64_t(num_executions), native_usec * 1000.0 / num_executions, script_usec * 1000.0 / num_executions)
+					.utf8()
+					.get_data());
+
+	memdelete(dummy);
 }
+#endif // MODULE_GDSCRIPT_ENABLED
 
 } //namespace TestTask
 
@@ -0,0 +1,158 @@
+/**
+ * test_utility_selector.h
+ * =============================================================================
+ * Copyright 2021-2024 Serhii Snitsaruk
+ *
+ * Use of this source code is governed by an MIT-style
+ * license that can be found in the LICENSE file or at
+ * https://opensource.org/licenses/MIT.
+ * =============================================================================
+ */
+
+#ifndef TEST_UTILITY_SELECTOR_H
+#define TEST_UTILITY_SELECTOR_H
+
+#include "limbo_test.h"
+
+#include "modules/limboai/blackboard/blackboard.h"
+#include "modules/limboai/bt/tasks/bt_task.h"
+#include "modules/limboai/bt/tasks/composites/bt_utility_selector.h"
+
+#include "core/io/stream_peer.h"
+
+namespace TestUtilitySelector {
+
+TEST_CASE("[Modules][LimboAI] BTUtilitySelector") {
+	Ref<BTUtilitySelector> sel = memnew(BTUtilitySelector);
+	Node *dummy = memnew(Node);
+	Ref<Blackboard> bb = memnew(Blackboard);
+
+	SUBCASE("When empty") {
+		sel->initialize(dummy, bb, dummy);
+		CHECK(sel->execute(0.01666) == BTTask::FAILURE);
+	}
+
+	Ref<BTTestAction> task1 = memnew(BTTestAction);
+	Ref<BTTestAction> task2 = memnew(BTTestAction);
+	Ref<BTTestAction> task3 = memnew(BTTestAction);
+	sel->add_child(task1);
+	sel->add_child(task2);
+	sel->add_child(task3);
+
+	bb->set_var("hunger", 0.2);
+	bb->set_var("fatigue", 0.6);
+	sel->set_consideration(0, "hunger");
+	sel->set_consideration(1, "fatigue");
+	sel->set_weight(2, 0.0);
+	sel->set_hysteresis(0.1);
+
+	SUBCASE("Should execute the child task with the highest score") {
+		sel->initialize(dummy, bb, dummy);
+		task2->ret_status = BTTask::RUNNING;
+
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK(sel->get_score(0) == doctest::Approx(0.2));
+		CHECK(sel->get_score(1) == doctest::Approx(0.6));
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::FRESH, 0, 0, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::RUNNING, 1, 1, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::FRESH, 0, 0, 0);
+
+		SUBCASE("Should keep the current choice within hysteresis") {
+			bb->set_var("hunger", 0.65);
+			CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::FRESH, 0, 0, 0);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::RUNNING, 1, 2, 0);
+		}
+		SUBCASE("Should switch and abort the current child when a better one emerges") {
+			bb->set_var("hunger", 0.9);
+			task1->ret_status = BTTask::RUNNING;
+			CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::RUNNING, 1, 1, 0);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FRESH, 1, 1, 1);
+		}
+		SUBCASE("Should not rescore before the interval elapses") {
+			sel->set_rescore_interval(1.0);
+			bb->set_var("hunger", 0.9);
+			CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::FRESH, 0, 0, 0);
+			CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::RUNNING, 1, 2, 0);
+		}
+	}
+
+	SUBCASE("When the best child task fails") {
+		sel->initialize(dummy, bb, dummy);
+		task2->ret_status = BTTask::FAILURE;
+		task1->ret_status = BTTask::SUCCESS;
+
+		CHECK(sel->execute(0.01666) == BTTask::SUCCESS);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::SUCCESS, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FAILURE, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::FRESH, 0, 0, 0); // Zero weight.
+	}
+
+	SUBCASE("When all eligible child tasks fail") {
+		sel->initialize(dummy, bb, dummy);
+		task1->ret_status = BTTask::FAILURE;
+		task2->ret_status = BTTask::FAILURE;
+
+		CHECK(sel->execute(0.01666) == BTTask::FAILURE);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::FAILURE, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FAILURE, 1, 1, 1);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task3, BTTask::FRESH, 0, 0, 0);
+	}
+
+	SUBCASE("With a response curve") {
+		Ref<Curve> curve = memnew(Curve);
+		curve->add_point(Vector2(0.0, 1.0));
+		curve->add_point(Vector2(1.0, 0.0));
+		sel->set_consideration(1, "fatigue", curve);
+		sel->initialize(dummy, bb, dummy);
+		task1->ret_status = BTTask::RUNNING;
+
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK(sel->get_score(1) == doctest::Approx(0.4).epsilon(0.01));
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::RUNNING, 1, 1, 0);
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::FRESH, 0, 0, 0);
+	}
+
+	SUBCASE("With a missing consideration variable") {
+		sel->set_consideration(0, "thirst");
+		ERR_PRINT_OFF; // Reported once when initialized.
+		sel->initialize(dummy, bb, dummy);
+		ERR_PRINT_ON;
+		task1->ret_status = BTTask::RUNNING;
+		task2->ret_status = BTTask::RUNNING;
+
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK(sel->get_score(0) == doctest::Approx(0.0));
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task2, BTTask::RUNNING, 1, 1, 0);
+
+		// * Variable is picked up once it's created.
+		bb->set_var("thirst", 0.9);
+		CHECK(sel->execute(0.01666) == BTTask::RUNNING);
+		CHECK(sel->get_score(0) == doctest::Approx(0.9));
+		CHECK_STATUS_ENTRIES_TICKS_EXITS(task1, BTTask::RUNNING, 1, 1, 0);
+	}
+
+	SUBCASE("When loading invalid state data") {
+		sel->initialize(dummy, bb, dummy);
+		for (int selected : { -2, 3 }) {
+			Ref<StreamPeerBuffer> buffer = memnew(StreamPeerBuffer);
+			buffer->put_u8(BTTask::RUNNING);
+			buffer->put_double(0.0);
+			buffer->put_32(selected);
+			buffer->put_double(0.0);
+			buffer->put_u32(3);
+			buffer->seek(0);
+			ERR_PRINT_OFF;
+			CHECK(sel->load_state(buffer) == ERR_INVALID_DATA);
+			ERR_PRINT_ON;
+		}
+	}
+
+	memdelete(dummy);
+}
+
+} //namespace TestUtilitySelector
+
+#endif // TEST_UTILITY_SELECTOR_H
@@ -30,6 +30,8 @@ LimboStringNames::LimboStringNames() {
 	_generate_name = SN("_generate_name");
 	_replace_task = SN("_replace_task");
 	_update_task_tree = SN("_update_task_tree");
+	_utility_curve_ = SN("_utility_curve_");
+	_utility_var_ = SN("_utility_var_");
 	_weight_ = SN("_weight_");
 	accent_color = SN("accent_color");
 	ActionCopy = SN("ActionCopy");
@@ -53,6 +55,7 @@ LimboStringNames::LimboStringNames() {
 	Debug = SN("Debug");
 	disabled_font_color = SN("disabled_font_color");
 	doc_italic = SN("doc_italic");
+	dot_dot = SN("..");
 	draw = SN("draw");
 	Duplicate = SN("Duplicate");
 	Edit = SN("Edit");
@@ -125,6 +128,7 @@ LimboStringNames::LimboStringNames() {
 	Save = SN("Save");
 	Script = SN("Script");
 	ScriptCreate = SN("ScriptCreate");
+	script_changed = SN("script_changed");
 	Search = SN("Search");
 	separation = SN("separation");
 	set_custom_name = SN("set_custom_name");
@@ -147,6 +151,7 @@ LimboStringNames::LimboStringNames() {
 	toggled = SN("toggled");
 	Tools = SN("Tools");
 	Tree = SN("Tree");
+	tree_exiting = SN("tree_exiting");
 	TripleBar = SN("TripleBar");
 	update_mode = SN("update_mode");
 	updated = SN("updated");
@@ -46,6 +46,8 @@ public:
 	StringName _generate_name;
 	StringName _replace_task;
 	StringName _update_task_tree;
+	StringName _utility_curve_;
+	StringName _utility_var_;
 	StringName _weight_;
 	StringName accent_color;
 	StringName ActionCopy;
@@ -69,6 +71,7 @@ public:
 	StringName Debug;
 	StringName disabled_font_color;
 	StringName doc_italic;
+	StringName dot_dot;
 	StringName draw;
 	StringName Duplicate;
 	StringName Edit;
@@ -141,6 +144,7 @@ public:
 	StringName Save;
 	StringName Script;
 	StringName ScriptCreate;
+	StringName script_changed;
 	StringName Search;
 	StringName separation;
 	StringName set_custom_name;
@@ -163,6 +167,7 @@ public:
 	StringName toggled;
 	StringName Tools;
 	StringName Tree;
+	StringName tree_exiting;
 	StringName TripleBar;
 	StringName update_mode;
 	StringName updated;
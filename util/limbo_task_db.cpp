@@ -26,6 +26,7 @@ using namespace godot;
 
 HashMap<String, List<String>> LimboTaskDB::core_tasks;
 HashMap<String, List<String>> LimboTaskDB::tasks_cache;
+HashSet<String> LimboTaskDB::thread_safe_tasks;
 
 _FORCE_INLINE_ void _populate_scripted_tasks_from_dir(String p_path, List<String> *p_task_classes) {
 	if (p_path.is_empty()) {
@@ -15,12 +15,14 @@
 #ifdef LIMBOAI_MODULE
 #include "core/object/class_db.h"
 #include "core/templates/hash_map.h"
+#include "core/templates/hash_set.h"
 #include "core/templates/list.h"
 #endif // LIMBOAI_MODULE
 
 #ifdef LIMBOAI_GDEXTENSION
 #include <godot_cpp/core/class_db.hpp>
 #include <godot_cpp/templates/hash_map.hpp>
+#include <godot_cpp/templates/hash_set.hpp>
 #include <godot_cpp/templates/list.hpp>
 #include <godot_cpp/variant/string.hpp>
 using namespace godot;
@@ -30,6 +32,7 @@ class LimboTaskDB {
 private:
 	static HashMap<String, List<String>> core_tasks;
 	static HashMap<String, List<String>> tasks_cache;
+	static HashSet<String> thread_safe_tasks;
 
 	struct ComparatorByTaskName {
 		bool operator()(const String &p_left, const String &p_right) const {
@@ -38,9 +41,14 @@ private:
 	};
 
 public:
+	// Thread-safe tasks don't access the scene tree, global state or other instances,
+	// and can be executed outside of the main thread.
 	template <class T>
-	static void register_task() {
+	static void register_task(bool p_thread_safe = false) {
 		GDREGISTER_CLASS(T);
+		if (p_thread_safe) {
+			thread_safe_tasks.insert(T::get_class_static());
+		}
 		HashMap<String, List<String>>::Iterator E = core_tasks.find(T::get_task_category());
 		if (E) {
 			E->value.push_back(T::get_class_static());
@@ -51,6 +59,8 @@ public:
 		}
 	}
 
+	static _FORCE_INLINE_ bool is_task_thread_safe(const String &p_class) { return thread_safe_tasks.has(p_class); }
+
 	static void scan_user_tasks();
 	static _FORCE_INLINE_ String get_misc_category() { return "Misc"; }
 	static List<String> get_categories();
@@ -69,8 +79,13 @@ public:
 	if (m_class::_class_is_enabled) {            \
 		::LimboTaskDB::register_task<m_class>(); \
 	}
+#define LIMBO_REGISTER_THREAD_SAFE_TASK(m_class)     \
+	if (m_class::_class_is_enabled) {                \
+		::LimboTaskDB::register_task<m_class>(true); \
+	}
 #elif LIMBOAI_GDEXTENSION
 #define LIMBO_REGISTER_TASK(m_class) LimboTaskDB::register_task<m_class>();
+#define LIMBO_REGISTER_THREAD_SAFE_TASK(m_class) LimboTaskDB::register_task<m_class>(true);
 #endif
 
 #define TASK_CATEGORY(m_cat)                           \